@@ -0,0 +1,313 @@
+#include "SceneBenchmark.h"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <Core/Camera.h>
+#include <Core/Components.h>
+#include <Core/FrameInfo.h>
+#include <Core/GpuProfiler.h>
+#include <Core/Scene.h>
+#include <Core/Trace.h>
+#include <Core/TransformSystem.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+
+namespace {
+    const char* const s_ModelFiles[] = { "cube.obj", "smooth_vase.obj", "flat_vase.obj", "colored_cube.obj" };
+    constexpr uint32_t s_ModelFileCount = static_cast<uint32_t>(std::size(s_ModelFiles));
+
+    // Fixed step so the camera path does not depend on how fast frames are
+    constexpr float s_FrameTime = 1.0f / 60.0f;
+
+    using Clock = std::chrono::steady_clock;
+
+    double Milliseconds(Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    void WriteDistribution(std::ostream& out, const char* name, const SceneBenchmark::Distribution& distribution) {
+        out << "\"" << name << "\": { \"avg\": " << distribution.average
+            << ", \"p50\": " << distribution.p50
+            << ", \"p95\": " << distribution.p95
+            << ", \"p99\": " << distribution.p99
+            << ", \"max\": " << distribution.max << " }";
+    }
+}
+
+SceneBenchmark::SceneBenchmark(const Config& config)
+    : m_Config{ config } {
+    m_Config.modelVariety = std::clamp(m_Config.modelVariety, 1u, s_ModelFileCount);
+
+    const VkExtent2D extent{ m_Config.width, m_Config.height };
+    if (m_Config.headless) {
+        m_pDevice = std::make_unique<Device>();
+        m_pRenderer = std::make_unique<Renderer>(*m_pDevice, extent);
+    }
+    else {
+        m_pWindow = std::make_unique<Window>(m_Config.width, m_Config.height, "Octo Benchmark");
+        m_pDevice = std::make_unique<Device>(*m_pWindow);
+        m_pRenderer = std::make_unique<Renderer>(*m_pWindow, *m_pDevice);
+    }
+
+    LoadModels();
+}
+
+SceneBenchmark::~SceneBenchmark() {
+    vkDeviceWaitIdle(m_pDevice->GetDevice());
+    m_Models.clear();
+    m_pRenderer.reset();
+    m_pDevice.reset();
+    m_pWindow.reset();
+}
+
+std::vector<SceneBenchmark::Result> SceneBenchmark::Run() {
+    std::vector<Result> results{};
+    for (uint32_t objectCount : m_Config.objectCounts) {
+        if (m_pWindow && m_pWindow->ShouldClose()) {
+            break;
+        }
+
+        std::cout << "benchmark: " << objectCount << " objects, " << GetRenderModeName(m_Config.renderMode) << std::endl;
+        results.push_back(RunScene(objectCount));
+    }
+    return results;
+}
+
+void SceneBenchmark::LoadModels() {
+    std::vector<std::string> filepaths{};
+    for (uint32_t i = 0; i < m_Config.modelVariety; i++) {
+        filepaths.push_back(m_Config.modelDirectory + s_ModelFiles[i]);
+    }
+
+    auto models = Model::CreateModels(*m_pDevice, filepaths);
+    for (auto& model : models) {
+        m_Models.push_back(std::move(model));
+    }
+
+    // Nothing may still be streaming in once frames are measured
+    m_pDevice->GetUploadManager().WaitIdle();
+}
+
+SceneBenchmark::Result SceneBenchmark::RunScene(uint32_t objectCount) {
+    TRACE_ZONE("SceneBenchmark::RunScene");
+
+    Result result{};
+    result.objectCount = objectCount;
+
+    // Objects fill a cube with spacing between neighbours on average
+    const auto buildStart = Clock::now();
+    Scene scene{};
+    TransformSystem transforms{ scene };
+
+    const float fieldSize = m_Config.spacing * std::cbrt(static_cast<float>(std::max(objectCount, 1u)));
+    const float fieldRadius = 0.5f * fieldSize * std::sqrt(3.0f);
+
+    std::mt19937 random{ m_Config.seed };
+    std::uniform_real_distribution<float> position{ -0.5f * fieldSize, 0.5f * fieldSize };
+    std::uniform_real_distribution<float> angle{ 0.0f, glm::two_pi<float>() };
+    std::uniform_real_distribution<float> scale{ 0.5f, 1.5f };
+    std::uniform_int_distribution<uint32_t> modelIndex{ 0, static_cast<uint32_t>(m_Models.size()) - 1 };
+
+    for (uint32_t i = 0; i < objectCount; i++) {
+        TransformComponent transform{};
+        transform.translation = glm::vec3{ position(random), position(random), position(random) };
+        transform.rotation = glm::vec3{ angle(random), angle(random), angle(random) };
+        transform.scale = glm::vec3{ scale(random) };
+
+        Entity entity = scene.Create();
+        scene.Add<MeshComponent>(entity, m_Models[modelIndex(random)]);
+        transforms.Attach(entity, transform);
+        scene.Add<BoundsComponent>(entity);
+    }
+    transforms.Update();
+    result.sceneBuildSeconds = std::chrono::duration<double>(Clock::now() - buildStart).count();
+
+    RenderSystem renderSystem{ *m_pDevice, m_pRenderer->GetSwapChainRenderPass() };
+    renderSystem.SetRenderMode(m_Config.renderMode);
+    // Frames would fall back to other modes while pipelines compile
+    m_pDevice->GetPipelineManager().WaitIdle();
+
+    GpuProfiler profiler{ *m_pDevice, false, std::max(m_Config.frames, 1u) };
+    Camera camera{};
+
+    std::vector<double> frameTimes{};
+    std::vector<double> cpuTimes{};
+    frameTimes.reserve(m_Config.frames);
+    cpuTimes.reserve(m_Config.frames);
+
+    const uint32_t totalFrames = m_Config.warmupFrames + m_Config.frames;
+    uint32_t frame = 0;
+    uint64_t drawCalls = 0;
+    uint64_t geometryBinds = 0;
+    uint64_t visibleObjects = 0;
+    uint64_t culledObjects = 0;
+
+    while (frame < totalFrames) {
+        if (m_pWindow) {
+            if (m_pWindow->ShouldClose()) {
+                break;
+            }
+            glfwPollEvents();
+        }
+
+        const auto frameStart = Clock::now();
+
+        // One orbit over the measured frames, moving in and out so levels of detail change
+        const float t = (static_cast<float>(frame) - static_cast<float>(m_Config.warmupFrames)) /
+            static_cast<float>(std::max(m_Config.frames, 1u));
+        const float orbit = glm::two_pi<float>() * t;
+        const float distance = fieldRadius * (1.3f + 0.7f * std::sin(2.0f * orbit)) + 2.0f;
+        const glm::vec3 eye{ distance * std::cos(orbit), -0.3f * distance, distance * std::sin(orbit) };
+        camera.SetViewTarget(eye, glm::vec3{ 0.0f });
+        camera.SetPerspectiveProjection(glm::radians(50.0f), m_pRenderer->GetAspectRatio(), 0.1f, 2.0f * distance + 2.0f * fieldRadius);
+
+        auto commandBuffer = m_pRenderer->BeginFrame();
+        if (!commandBuffer) {
+            continue;
+        }
+        const auto recordStart = Clock::now();
+
+        FrameInfo frameInfo{
+            m_pRenderer->GetFrameIndex(),
+            s_FrameTime,
+            commandBuffer,
+            camera,
+            m_pRenderer->GetSwapChainExtent(),
+            &m_pRenderer->GetCurrentFrameContext() };
+
+        profiler.BeginFrame(commandBuffer, frameInfo.frameIndex);
+        {
+            GpuProfiler::Scope scope{ profiler, commandBuffer, "Frame" };
+            renderSystem.PrepareGameObjects(frameInfo, scene);
+            m_pRenderer->BeginSwapChainRenderPass(commandBuffer, renderSystem.GetSubpassContents());
+            renderSystem.RenderGameObjects(frameInfo, scene);
+            m_pRenderer->EndSwapChainRenderPass(commandBuffer);
+        }
+        m_pRenderer->EndFrame();
+
+        const auto frameEnd = Clock::now();
+        // Timestamps come back MAX_FRAMES_IN_FLIGHT frames late, the next BeginFrame collects
+        // the first measured frame
+        if (frame + 1 == m_Config.warmupFrames + SwapChain::MAX_FRAMES_IN_FLIGHT) {
+            profiler.ResetHistory();
+        }
+        if (frame >= m_Config.warmupFrames) {
+            frameTimes.push_back(Milliseconds(frameEnd - frameStart));
+            cpuTimes.push_back(Milliseconds(frameEnd - recordStart));
+            drawCalls += frameInfo.stats.drawCount;
+            geometryBinds += frameInfo.stats.geometryBindCount;
+            visibleObjects += frameInfo.stats.objectCount - frameInfo.stats.culledCount;
+            culledObjects += frameInfo.stats.culledCount;
+        }
+        frame++;
+    }
+
+    // The last frames' timestamps would only be read once their frame index comes around again
+    vkDeviceWaitIdle(m_pDevice->GetDevice());
+    profiler.CollectAll();
+
+    result.frames = static_cast<uint32_t>(frameTimes.size());
+    result.frameTime = Summarize(frameTimes);
+    result.cpuTime = Summarize(cpuTimes);
+    for (const auto& stats : profiler.GetStats()) {
+        if (stats.name == "Frame" && stats.sampleCount > 0) {
+            result.gpuTime = Distribution{ stats.averageMs, stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs };
+            result.hasGpuTime = true;
+        }
+    }
+
+    if (result.frames > 0) {
+        const double frames = static_cast<double>(result.frames);
+        result.drawCalls = static_cast<double>(drawCalls) / frames;
+        result.geometryBinds = static_cast<double>(geometryBinds) / frames;
+        result.visibleObjects = static_cast<double>(visibleObjects) / frames;
+        result.culledObjects = static_cast<double>(culledObjects) / frames;
+    }
+
+    return result;
+}
+
+void SceneBenchmark::WriteJson(std::ostream& out, const std::vector<Result>& results) const {
+    out << std::fixed << std::setprecision(4);
+    out << "{\n";
+    out << "  \"device\": \"" << m_pDevice->properties.deviceName << "\",\n";
+    out << "  \"config\": { \"modelVariety\": " << m_Config.modelVariety
+        << ", \"warmupFrames\": " << m_Config.warmupFrames
+        << ", \"frames\": " << m_Config.frames
+        << ", \"width\": " << m_Config.width
+        << ", \"height\": " << m_Config.height
+        << ", \"headless\": " << (m_Config.headless ? "true" : "false")
+        << ", \"renderMode\": \"" << GetRenderModeName(m_Config.renderMode) << "\""
+        << ", \"seed\": " << m_Config.seed
+        << ", \"spacing\": " << m_Config.spacing << " },\n";
+    out << "  \"results\": [";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    { ";
+        out << "\"objects\": " << result.objectCount
+            << ", \"frames\": " << result.frames
+            << ", \"sceneBuildSeconds\": " << result.sceneBuildSeconds << ",\n      ";
+        WriteDistribution(out, "frameMs", result.frameTime);
+        out << ",\n      ";
+        WriteDistribution(out, "cpuMs", result.cpuTime);
+        out << ",\n      ";
+        if (result.hasGpuTime) {
+            WriteDistribution(out, "gpuMs", result.gpuTime);
+        }
+        else {
+            out << "\"gpuMs\": null";
+        }
+        out << ",\n      \"drawCalls\": " << result.drawCalls
+            << ", \"geometryBinds\": " << result.geometryBinds
+            << ", \"visibleObjects\": " << result.visibleObjects
+            << ", \"culledObjects\": " << result.culledObjects << " }";
+    }
+
+    out << "\n  ]\n}\n";
+}
+
+const char* SceneBenchmark::GetRenderModeName(RenderSystem::RenderMode mode) {
+    switch (mode) {
+    case RenderSystem::RenderMode::Direct:     return "direct";
+    case RenderSystem::RenderMode::Instanced:  return "instanced";
+    case RenderSystem::RenderMode::Indirect:   return "indirect";
+    case RenderSystem::RenderMode::Parallel:   return "parallel";
+    }
+    return "unknown";
+}
+
+SceneBenchmark::Distribution SceneBenchmark::Summarize(std::vector<double> samples) {
+    Distribution distribution{};
+    if (samples.empty()) {
+        return distribution;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double p) {
+        const size_t rank = static_cast<size_t>(p * static_cast<double>(samples.size() - 1) + 0.5);
+        return samples[std::min(rank, samples.size() - 1)];
+    };
+
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+
+    distribution.average = total / static_cast<double>(samples.size());
+    distribution.p50 = percentile(0.50);
+    distribution.p95 = percentile(0.95);
+    distribution.p99 = percentile(0.99);
+    distribution.max = samples.back();
+    return distribution;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Core/Device.h>
+#include <Core/Model.h>
+#include <Core/Renderer.h>
+#include <Core/RenderSystem.h>
+#include <Core/Window.h>
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Renders procedurally placed scenes of many objects along a fixed camera path and measures
+// every frame. Placement, camera and frame time steps only depend on the config, so two
+// runs with the same config render the same frames.
+class SceneBenchmark {
+public:
+    static constexpr const char* s_DefaultModelDirectory = "C:\\dev\\VkTest\\VkTest\\src\\Resource\\models\\";
+
+    struct Config {
+        std::vector<uint32_t>   objectCounts{ 1000 };   // one run per count
+        uint32_t                modelVariety = 2;       // distinct models, cube.obj and smooth_vase.obj first
+        uint32_t                warmupFrames = 60;
+        uint32_t                frames = 600;           // measured, one camera orbit
+        uint32_t                width = 1280;
+        uint32_t                height = 720;
+        bool                    headless = true;
+        RenderSystem::RenderMode renderMode = RenderSystem::RenderMode::Indirect;
+        uint32_t                seed = 1;
+        float                   spacing = 2.0f;         // average distance between neighbouring objects
+        std::string             modelDirectory = s_DefaultModelDirectory;
+    };
+
+    // Milliseconds over the measured frames
+    struct Distribution {
+        double average = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    struct Result {
+        uint32_t        objectCount = 0;
+        uint32_t        frames = 0;
+        double          sceneBuildSeconds = 0.0;
+        Distribution    frameTime{};    // wall time of a whole frame, fence waits included
+        Distribution    cpuTime{};      // culling, recording and submission only
+        Distribution    gpuTime{};      // timestamps around all of the frame's commands
+        bool            hasGpuTime = false;
+        double          drawCalls = 0.0;        // averages per frame
+        double          geometryBinds = 0.0;
+        double          visibleObjects = 0.0;
+        double          culledObjects = 0.0;
+    };
+public:
+    explicit SceneBenchmark(const Config& config);
+    ~SceneBenchmark();
+
+    SceneBenchmark(const SceneBenchmark&) = delete;
+    SceneBenchmark& operator=(const SceneBenchmark&) = delete;
+
+    SceneBenchmark(SceneBenchmark&&) = delete;
+    SceneBenchmark& operator=(SceneBenchmark&&) = delete;
+public:
+    std::vector<Result> Run();
+    void WriteJson(std::ostream& out, const std::vector<Result>& results) const;
+
+    static const char* GetRenderModeName(RenderSystem::RenderMode mode);
+    static Distribution Summarize(std::vector<double> samples);
+private:
+    Result RunScene(uint32_t objectCount);
+    void LoadModels();
+private:
+    Config									m_Config;
+    std::unique_ptr<Window>					m_pWindow;
+    std::unique_ptr<Device>					m_pDevice;
+    std::unique_ptr<Renderer>				m_pRenderer;
+    std::vector<std::shared_ptr<Model>>		m_Models;
+};
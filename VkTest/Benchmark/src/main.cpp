@@ -0,0 +1,138 @@
+#include "SceneBenchmark.h"
+
+#include <Core/Trace.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    void PrintUsage() {
+        std::cout <<
+            "usage: Benchmark [options]\n"
+            "  --objects N[,N...]   object counts, one run each (default 1000)\n"
+            "  --variety N          distinct models, 1 to 4 (default 2)\n"
+            "  --frames N           measured frames, one camera orbit (default 600)\n"
+            "  --warmup N           frames rendered before measuring (default 60)\n"
+            "  --mode NAME          direct, instanced, indirect or parallel (default indirect)\n"
+            "  --size WxH           render extent (default 1280x720)\n"
+            "  --windowed           render to a window instead of offscreen\n"
+            "  --seed N             placement seed (default 1)\n"
+            "  --models DIR         directory holding the bundled .obj files\n"
+            "  --out FILE           JSON report path (default benchmark.json)\n"
+            "  --trace FILE         also write a Chrome trace, when zones are compiled in\n";
+    }
+
+    uint32_t ParseCount(const std::string& text) {
+        size_t end = 0;
+        const unsigned long value = std::stoul(text, &end);
+        if (end != text.size()) {
+            throw std::runtime_error("Not a number: " + text);
+        }
+        return static_cast<uint32_t>(value);
+    }
+
+    RenderSystem::RenderMode ParseRenderMode(const std::string& name) {
+        for (auto mode : { RenderSystem::RenderMode::Direct, RenderSystem::RenderMode::Instanced,
+                RenderSystem::RenderMode::Indirect, RenderSystem::RenderMode::Parallel }) {
+            if (name == SceneBenchmark::GetRenderModeName(mode)) {
+                return mode;
+            }
+        }
+        throw std::runtime_error("Unknown render mode: " + name);
+    }
+}
+
+int main(int argc, char** argv) {
+    SceneBenchmark::Config config{};
+    std::string outPath = "benchmark.json";
+    std::string tracePath{};
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error("Missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--objects") {
+                config.objectCounts.clear();
+                std::stringstream list{ value() };
+                std::string count;
+                while (std::getline(list, count, ',')) {
+                    config.objectCounts.push_back(ParseCount(count));
+                }
+            }
+            else if (arg == "--variety") {
+                config.modelVariety = ParseCount(value());
+            }
+            else if (arg == "--frames") {
+                config.frames = ParseCount(value());
+            }
+            else if (arg == "--warmup") {
+                config.warmupFrames = ParseCount(value());
+            }
+            else if (arg == "--mode") {
+                config.renderMode = ParseRenderMode(value());
+            }
+            else if (arg == "--size") {
+                const std::string size = value();
+                const size_t x = size.find('x');
+                if (x == std::string::npos) {
+                    throw std::runtime_error("Expected WxH: " + size);
+                }
+                config.width = ParseCount(size.substr(0, x));
+                config.height = ParseCount(size.substr(x + 1));
+            }
+            else if (arg == "--windowed") {
+                config.headless = false;
+            }
+            else if (arg == "--seed") {
+                config.seed = ParseCount(value());
+            }
+            else if (arg == "--models") {
+                config.modelDirectory = value();
+                if (!config.modelDirectory.empty() && config.modelDirectory.back() != '/' && config.modelDirectory.back() != '\\') {
+                    config.modelDirectory += '/';
+                }
+            }
+            else if (arg == "--out") {
+                outPath = value();
+            }
+            else if (arg == "--trace") {
+                tracePath = value();
+            }
+            else {
+                PrintUsage();
+                return arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+            }
+        }
+
+        SceneBenchmark benchmark{ config };
+        const auto results = benchmark.Run();
+
+        // Not stdout, device setup and model loading already log there
+        std::ofstream file{ outPath, std::ios::trunc };
+        if (!file) {
+            throw std::runtime_error("Failed to open " + outPath);
+        }
+        benchmark.WriteJson(file, results);
+        std::cout << "benchmark: wrote " << results.size() << " results to " << outPath << std::endl;
+
+        if (!tracePath.empty()) {
+            Trace::WriteChromeTrace(tracePath);
+        }
+    }
+    catch (std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
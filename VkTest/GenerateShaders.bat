@@ -1,3 +1,9 @@
-C:\VulkanSDK\1.2.198.1\Bin\glslc.exe VkTest\src\Shaders\source.vert -o VkTest\src\Shaders\spv.vert
-C:\VulkanSDK\1.2.198.1\Bin\glslc.exe VkTest\src\Shaders\source.frag -o VkTest\src\Shaders\spv.frag
+C:\VulkanSDK\1.2.198.1\Bin\glslc.exe VkTest\src\Shaders\source.vert -o VkTest\src\Shaders\spv.vert
+C:\VulkanSDK\1.2.198.1\Bin\glslc.exe VkTest\src\Shaders\source.frag -o VkTest\src\Shaders\spv.frag
+C:\VulkanSDK\1.2.198.1\Bin\glslc.exe VkTest\src\Shaders\instanced.vert -o VkTest\src\Shaders\spv_instanced.vert
+C:\VulkanSDK\1.2.198.1\Bin\glslc.exe VkTest\src\Shaders\indirect.vert -o VkTest\src\Shaders\spv_indirect.vert
+C:\VulkanSDK\1.2.198.1\Bin\glslc.exe VkTest\src\Shaders\cull.comp -o VkTest\src\Shaders\spv_cull.comp
+C:\VulkanSDK\1.2.198.1\Bin\glslc.exe -DPACKED_VERTEX VkTest\src\Shaders\source.vert -o VkTest\src\Shaders\spv_packed.vert
+C:\VulkanSDK\1.2.198.1\Bin\glslc.exe -DPACKED_VERTEX VkTest\src\Shaders\instanced.vert -o VkTest\src\Shaders\spv_packed_instanced.vert
+C:\VulkanSDK\1.2.198.1\Bin\glslc.exe -DPACKED_VERTEX VkTest\src\Shaders\indirect.vert -o VkTest\src\Shaders\spv_packed_indirect.vert
 PAUSE
\ No newline at end of file
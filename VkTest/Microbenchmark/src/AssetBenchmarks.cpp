@@ -0,0 +1,84 @@
+#include "Benchmarks.h"
+#include "Microbenchmark.h"
+
+#include <Core/Model.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    const char* const s_ModelFiles[] = { "cube.obj", "smooth_vase.obj", "flat_vase.obj", "colored_cube.obj" };
+    // Largest of the bundled meshes, the one the hash benchmarks run on
+    const char* const s_HashModelFile = "smooth_vase.obj";
+
+    // Items are face corners, which is what both the parser and the dedup loop walk
+    uint64_t CornerCount(const Model::Builder& builder) {
+        return builder.indices.empty() ? builder.vertices.size() : builder.indices.size();
+    }
+}
+
+void RegisterAssetBenchmarks(const std::string& modelDirectory) {
+    for (const char* file : s_ModelFiles) {
+        const std::string filepath = modelDirectory + file;
+
+        // What startup pays once the mesh cache is warm, the first call outside the timed
+        // loop writes the cache if needed
+        Microbenchmark::Register(std::string{ "LoadModel/" } + file, [filepath](Microbenchmark::State& state) {
+            Model::Builder warm{};
+            warm.LoadModel(filepath);
+
+            for (auto _ : state) {
+                Model::Builder builder{};
+                builder.LoadModel(filepath);
+                Microbenchmark::DoNotOptimize(builder);
+            }
+            state.SetItemsProcessed(state.GetIterations() * CornerCount(warm));
+        });
+
+        // A cache miss without the optimizer, parsing and parallel deduplication only
+        Microbenchmark::Register(std::string{ "ParseObj/" } + file, [filepath](Microbenchmark::State& state) {
+            Model::Builder builder{};
+            for (auto _ : state) {
+                builder.ParseObj(filepath);
+                Microbenchmark::DoNotOptimize(builder);
+            }
+            state.SetItemsProcessed(state.GetIterations() * CornerCount(builder));
+        });
+    }
+
+    // Every face corner of a loaded mesh in index order, duplicates included, like the
+    // corners ParseObj hashes before deduplicating them
+    auto corners = std::make_shared<std::vector<Model::Vertex>>();
+    {
+        Model::Builder builder{};
+        builder.LoadModel(modelDirectory + s_HashModelFile);
+        for (uint32_t index : builder.indices) {
+            corners->push_back(builder.vertices[index]);
+        }
+    }
+
+    Microbenchmark::Register("std::hash<Model::Vertex>", [corners](Microbenchmark::State& state) {
+        for (auto _ : state) {
+            size_t combined = 0;
+            for (const auto& vertex : *corners) {
+                combined ^= std::hash<Model::Vertex>{}(vertex);
+            }
+            Microbenchmark::DoNotOptimize(combined);
+        }
+        state.SetItemsProcessed(state.GetIterations() * corners->size());
+    });
+
+    // Serial equivalent of one ParseObj shard, hash, probe and compare against earlier corners
+    Microbenchmark::Register("VertexDedup", [corners](Microbenchmark::State& state) {
+        for (auto _ : state) {
+            std::unordered_map<Model::Vertex, uint32_t> unique{};
+            unique.reserve(corners->size());
+            for (const auto& vertex : *corners) {
+                unique.emplace(vertex, static_cast<uint32_t>(unique.size()));
+            }
+            Microbenchmark::DoNotOptimize(unique);
+        }
+        state.SetItemsProcessed(state.GetIterations() * corners->size());
+    });
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <string>
+
+// Model loading and vertex deduplication, on the bundled .obj files in modelDirectory
+void RegisterAssetBenchmarks(const std::string& modelDirectory);
+// Transform and camera matrices, the per frame math
+void RegisterMathBenchmarks();
@@ -0,0 +1,100 @@
+#include "Benchmarks.h"
+#include "Microbenchmark.h"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <Core/Camera.h>
+#include <Core/Components.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+    // Inputs per iteration, enough to leave the loop overhead out of the numbers while
+    // staying in L1 and L2
+    constexpr size_t s_BatchSize = 4096;
+
+    struct Inputs {
+        std::vector<TransformComponent> transforms{};
+        std::vector<glm::vec3> positions{};
+        std::vector<glm::vec3> rotations{};
+        std::vector<float> aspects{};
+    };
+
+    // Fixed seed, every run sees the same values
+    std::shared_ptr<const Inputs> CreateInputs() {
+        auto inputs = std::make_shared<Inputs>();
+
+        std::mt19937 generator{ 1 };
+        std::uniform_real_distribution<float> position{ -100.0f, 100.0f };
+        std::uniform_real_distribution<float> angle{ -glm::pi<float>(), glm::pi<float>() };
+        std::uniform_real_distribution<float> scale{ 0.1f, 10.0f };
+        std::uniform_real_distribution<float> aspect{ 0.5f, 2.5f };
+
+        for (size_t i = 0; i < s_BatchSize; i++) {
+            TransformComponent transform{};
+            transform.translation = { position(generator), position(generator), position(generator) };
+            transform.scale = { scale(generator), scale(generator), scale(generator) };
+            transform.rotation = { angle(generator), angle(generator), angle(generator) };
+            inputs->transforms.push_back(transform);
+
+            inputs->positions.push_back({ position(generator), position(generator), position(generator) });
+            inputs->rotations.push_back({ angle(generator), angle(generator), angle(generator) });
+            inputs->aspects.push_back(aspect(generator));
+        }
+
+        return inputs;
+    }
+}
+
+void RegisterMathBenchmarks() {
+    const auto inputs = CreateInputs();
+
+    Microbenchmark::Register("TransformComponent::mat4", [inputs](Microbenchmark::State& state) {
+        std::vector<glm::mat4> matrices(s_BatchSize);
+        for (auto _ : state) {
+            for (size_t i = 0; i < s_BatchSize; i++) {
+                matrices[i] = inputs->transforms[i].mat4();
+            }
+            Microbenchmark::DoNotOptimize(matrices[0]);
+        }
+        state.SetItemsProcessed(state.GetIterations() * s_BatchSize);
+    });
+
+    Microbenchmark::Register("TransformComponent::NormalMatrix", [inputs](Microbenchmark::State& state) {
+        std::vector<glm::mat3> matrices(s_BatchSize);
+        for (auto _ : state) {
+            for (size_t i = 0; i < s_BatchSize; i++) {
+                matrices[i] = inputs->transforms[i].NormalMatrix();
+            }
+            Microbenchmark::DoNotOptimize(matrices[0]);
+        }
+        state.SetItemsProcessed(state.GetIterations() * s_BatchSize);
+    });
+
+    Microbenchmark::Register("Camera::SetViewYXZ", [inputs](Microbenchmark::State& state) {
+        Camera camera{};
+        for (auto _ : state) {
+            for (size_t i = 0; i < s_BatchSize; i++) {
+                camera.SetViewYXZ(inputs->positions[i], inputs->rotations[i]);
+                Microbenchmark::DoNotOptimize(camera);
+            }
+        }
+        state.SetItemsProcessed(state.GetIterations() * s_BatchSize);
+    });
+
+    Microbenchmark::Register("Camera::SetPerspectiveProjection", [inputs](Microbenchmark::State& state) {
+        Camera camera{};
+        for (auto _ : state) {
+            for (size_t i = 0; i < s_BatchSize; i++) {
+                camera.SetPerspectiveProjection(glm::radians(50.0f), inputs->aspects[i], 0.1f, 100.0f);
+                Microbenchmark::DoNotOptimize(camera);
+            }
+        }
+        state.SetItemsProcessed(state.GetIterations() * s_BatchSize);
+    });
+}
@@ -0,0 +1,207 @@
+#include "Microbenchmark.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    struct Registration {
+        std::string					name;
+        Microbenchmark::Function	function;
+    };
+
+    std::vector<Registration>& GetRegistrations() {
+        static std::vector<Registration> registrations{};
+        return registrations;
+    }
+
+    const void* volatile s_Sink = nullptr;
+
+    double Median(std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        const size_t middle = values.size() / 2;
+        return values.size() % 2 == 1 ? values[middle] : 0.5 * (values[middle - 1] + values[middle]);
+    }
+
+    // Pulls the value out of "key": value on a line written by WriteJson
+    bool FindValue(const std::string& line, const std::string& key, std::string& value) {
+        const std::string quotedKey = "\"" + key + "\":";
+        size_t begin = line.find(quotedKey);
+        if (begin == std::string::npos) {
+            return false;
+        }
+        begin += quotedKey.size();
+        while (begin < line.size() && line[begin] == ' ') {
+            begin++;
+        }
+
+        if (begin < line.size() && line[begin] == '"') {
+            const size_t end = line.find('"', begin + 1);
+            if (end == std::string::npos) {
+                return false;
+            }
+            value = line.substr(begin + 1, end - begin - 1);
+            return true;
+        }
+
+        const size_t end = line.find_first_of(",}", begin);
+        value = line.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+        return true;
+    }
+}
+
+Microbenchmark::State::Iterator Microbenchmark::State::begin() {
+    ResumeTiming();
+    return Iterator{ this, m_Iterations };
+}
+
+void Microbenchmark::State::PauseTiming() {
+    StopTiming();
+}
+
+void Microbenchmark::State::ResumeTiming() {
+    m_Start = Clock::now();
+    m_Running = true;
+}
+
+void Microbenchmark::State::StopTiming() {
+    if (m_Running) {
+        m_Elapsed += Clock::now() - m_Start;
+        m_Running = false;
+    }
+}
+
+void Microbenchmark::Register(const std::string& name, Function function) {
+    GetRegistrations().push_back({ name, std::move(function) });
+}
+
+std::vector<Microbenchmark::Result> Microbenchmark::RunAll(const Options& options) {
+    constexpr uint64_t maxIterations = 1000000000;
+
+    std::vector<Result> results{};
+    for (const auto& registration : GetRegistrations()) {
+        if (!options.filter.empty() && registration.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+
+        // Same growth rule as Google Benchmark, aim 40% past the target and at most 10x per step
+        uint64_t iterations = 1;
+        while (true) {
+            State state{ iterations };
+            registration.function(state);
+
+            const double seconds = state.GetSeconds();
+            if (seconds >= options.minSeconds || iterations >= maxIterations) {
+                break;
+            }
+
+            const double scale = seconds > 0.0 ? options.minSeconds * 1.4 / seconds : 10.0;
+            const double next = static_cast<double>(iterations) * std::clamp(scale, 2.0, 10.0);
+            iterations = std::min(static_cast<uint64_t>(next), maxIterations);
+        }
+
+        std::vector<double> nsPerIteration{};
+        std::vector<double> itemsPerSecond{};
+        for (uint32_t repetition = 0; repetition < std::max(options.repetitions, 1u); repetition++) {
+            State state{ iterations };
+            registration.function(state);
+
+            const double seconds = std::max(state.GetSeconds(), 1e-12);
+            nsPerIteration.push_back(seconds * 1e9 / static_cast<double>(iterations));
+            itemsPerSecond.push_back(static_cast<double>(state.GetItemsProcessed()) / seconds);
+        }
+
+        Result result{};
+        result.name = registration.name;
+        result.iterations = iterations;
+        result.nsPerIteration = Median(nsPerIteration);
+        result.itemsPerSecond = Median(itemsPerSecond);
+        if (result.itemsPerSecond > 0.0) {
+            const auto [min, max] = std::minmax_element(itemsPerSecond.begin(), itemsPerSecond.end());
+            result.spread = (*max - *min) / result.itemsPerSecond;
+        }
+
+        std::cout << std::left << std::setw(40) << result.name << std::right
+            << std::setw(14) << std::fixed << std::setprecision(1) << result.nsPerIteration << " ns"
+            << std::setw(14) << std::setprecision(3) << result.itemsPerSecond * 1e-6 << " M items/s"
+            << std::setw(8) << std::setprecision(1) << result.spread * 100.0 << "% spread"
+            << std::setw(12) << iterations << " iterations" << std::endl;
+
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+void Microbenchmark::WriteJson(std::ostream& out, const std::vector<Result>& results) {
+    // One benchmark per line, which is all ReadBaseline understands
+    out << "{\n  \"benchmarks\": [\n";
+    out << std::setprecision(9);
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        out << "    {\"name\": \"" << result.name << "\""
+            << ", \"iterations\": " << result.iterations
+            << ", \"nsPerIteration\": " << result.nsPerIteration
+            << ", \"itemsPerSecond\": " << result.itemsPerSecond
+            << ", \"spread\": " << result.spread << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+Microbenchmark::Baseline Microbenchmark::ReadBaseline(std::istream& in) {
+    Baseline baseline{};
+
+    std::string line;
+    while (std::getline(in, line)) {
+        std::string name, itemsPerSecond;
+        if (!FindValue(line, "name", name) || !FindValue(line, "itemsPerSecond", itemsPerSecond)) {
+            continue;
+        }
+
+        std::istringstream value{ itemsPerSecond };
+        double parsed = 0.0;
+        if (value >> parsed) {
+            baseline[name] = parsed;
+        }
+    }
+
+    return baseline;
+}
+
+bool Microbenchmark::CompareToBaseline(const std::vector<Result>& results, const Baseline& baseline, double threshold) {
+    bool passed = true;
+
+    std::cout << "\nmicrobenchmark: against baseline, threshold " << std::fixed << std::setprecision(1)
+        << threshold * 100.0 << "%" << std::endl;
+    for (const auto& result : results) {
+        std::cout << std::left << std::setw(40) << result.name << std::right;
+
+        auto it = baseline.find(result.name);
+        if (it == baseline.end() || it->second <= 0.0) {
+            std::cout << "  not in baseline" << std::endl;
+            continue;
+        }
+
+        const double change = result.itemsPerSecond / it->second - 1.0;
+        const bool regressed = change < -threshold;
+        passed = passed && !regressed;
+
+        std::cout << std::setw(14) << std::setprecision(3) << it->second * 1e-6 << " -> "
+            << std::setw(10) << result.itemsPerSecond * 1e-6 << " M items/s"
+            << std::setw(9) << std::showpos << std::setprecision(1) << change * 100.0 << std::noshowpos << "%"
+            << (regressed ? "  REGRESSION" : "") << std::endl;
+    }
+
+    return passed;
+}
+
+#ifdef _MSC_VER
+__declspec(noinline)
+#else
+__attribute__((noinline))
+#endif
+void Microbenchmark::Escape(const void* pointer) {
+    s_Sink = pointer;
+}
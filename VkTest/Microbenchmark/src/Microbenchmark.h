@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Minimal Google Benchmark lookalike. A benchmark body loops over its State and reports how
+// many items it handled, the runner grows the iteration count until a run lasts long enough,
+// repeats it and keeps the median. Results can be written as JSON and compared to a baseline.
+//
+//     void LoadSomething(Microbenchmark::State& state) {
+//         for (auto _ : state) { ... }
+//         state.SetItemsProcessed(state.GetIterations() * itemsPerIteration);
+//     }
+class Microbenchmark {
+public:
+    class State {
+    public:
+        class Iterator {
+        public:
+            Iterator(State* state, uint64_t remaining) : m_pState{ state }, m_Remaining{ remaining } {}
+
+            int operator*() const { return 0; }
+            void operator++() { m_Remaining--; }
+            // The clock stops as soon as the last iteration is done
+            bool operator!=(const Iterator&) {
+                if (m_Remaining != 0) {
+                    return true;
+                }
+                m_pState->StopTiming();
+                return false;
+            }
+        private:
+            State*		m_pState;
+            uint64_t	m_Remaining;
+        };
+    public:
+        explicit State(uint64_t iterations) : m_Iterations{ iterations } {}
+
+        Iterator begin();
+        Iterator end() { return Iterator{ this, 0 }; }
+
+        // For per iteration setup that should not count
+        void PauseTiming();
+        void ResumeTiming();
+
+        void SetItemsProcessed(uint64_t items) { m_ItemsProcessed = items; }
+        uint64_t GetIterations() const { return m_Iterations; }
+        uint64_t GetItemsProcessed() const { return m_ItemsProcessed; }
+        double GetSeconds() const { return std::chrono::duration<double>(m_Elapsed).count(); }
+    private:
+        void StopTiming();
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        uint64_t			m_Iterations;
+        uint64_t			m_ItemsProcessed = 0;
+        Clock::time_point	m_Start{};
+        Clock::duration		m_Elapsed{};
+        bool				m_Running = false;
+    };
+
+    using Function = std::function<void(State&)>;
+
+    struct Options {
+        double		minSeconds = 0.5;       // per repetition
+        uint32_t	repetitions = 5;
+        std::string	filter{};               // substring of the name, empty runs everything
+    };
+
+    struct Result {
+        std::string	name;
+        uint64_t	iterations = 0;         // per repetition
+        double		nsPerIteration = 0.0;   // median
+        double		itemsPerSecond = 0.0;   // median
+        double		spread = 0.0;           // (max - min) / median of items per second
+    };
+
+    // Items per second by benchmark name
+    using Baseline = std::map<std::string, double>;
+public:
+    static void Register(const std::string& name, Function function);
+    static std::vector<Result> RunAll(const Options& options);
+
+    static void WriteJson(std::ostream& out, const std::vector<Result>& results);
+    // Reads what WriteJson wrote, anything else in the file is ignored
+    static Baseline ReadBaseline(std::istream& in);
+    // Prints the change against the baseline, returns false if anything got slower than
+    // threshold, a fraction of the baseline throughput
+    static bool CompareToBaseline(const std::vector<Result>& results, const Baseline& baseline, double threshold);
+
+    // Keeps the compiler from dropping work whose result is never read
+    template <typename T>
+    static void DoNotOptimize(const T& value) {
+        Escape(&value);
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+private:
+    static void Escape(const void* pointer);
+};
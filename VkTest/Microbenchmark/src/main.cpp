@@ -0,0 +1,115 @@
+#include "Benchmarks.h"
+#include "Microbenchmark.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+    const char* const s_DefaultModelDirectory = "C:\\dev\\VkTest\\VkTest\\src\\Resource\\models\\";
+
+    void PrintUsage() {
+        std::cout <<
+            "usage: Microbenchmark [options]\n"
+            "  --filter TEXT        only run benchmarks whose name contains TEXT\n"
+            "  --min-time SECONDS   minimum duration of one repetition (default 0.5)\n"
+            "  --repetitions N      repetitions per benchmark, the median is reported (default 5)\n"
+            "  --models DIR         directory holding the bundled .obj files\n"
+            "  --out FILE           JSON report path (default microbenchmark.json)\n"
+            "  --baseline FILE      compare against an earlier report, fails on regressions\n"
+            "  --threshold PERCENT  allowed throughput loss against the baseline (default 5)\n"
+            "Measure release builds, debug builds also record trace zones.\n";
+    }
+
+    double ParseNumber(const std::string& text) {
+        size_t end = 0;
+        const double value = std::stod(text, &end);
+        if (end != text.size() || value < 0.0) {
+            throw std::runtime_error("Not a positive number: " + text);
+        }
+        return value;
+    }
+}
+
+int main(int argc, char** argv) {
+    Microbenchmark::Options options{};
+    std::string modelDirectory = s_DefaultModelDirectory;
+    std::string outPath = "microbenchmark.json";
+    std::string baselinePath{};
+    double threshold = 0.05;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::runtime_error("Missing value for " + arg);
+                }
+                return argv[++i];
+            };
+
+            if (arg == "--filter") {
+                options.filter = value();
+            }
+            else if (arg == "--min-time") {
+                options.minSeconds = ParseNumber(value());
+            }
+            else if (arg == "--repetitions") {
+                options.repetitions = static_cast<uint32_t>(ParseNumber(value()));
+            }
+            else if (arg == "--models") {
+                modelDirectory = value();
+                if (!modelDirectory.empty() && modelDirectory.back() != '/' && modelDirectory.back() != '\\') {
+                    modelDirectory += '/';
+                }
+            }
+            else if (arg == "--out") {
+                outPath = value();
+            }
+            else if (arg == "--baseline") {
+                baselinePath = value();
+            }
+            else if (arg == "--threshold") {
+                threshold = ParseNumber(value()) * 0.01;
+            }
+            else {
+                PrintUsage();
+                return arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+            }
+        }
+
+        // Read before running, a bad path should not cost a full run
+        Microbenchmark::Baseline baseline{};
+        if (!baselinePath.empty()) {
+            std::ifstream file{ baselinePath };
+            if (!file) {
+                throw std::runtime_error("Failed to open " + baselinePath);
+            }
+            baseline = Microbenchmark::ReadBaseline(file);
+        }
+
+        RegisterAssetBenchmarks(modelDirectory);
+        RegisterMathBenchmarks();
+
+        const auto results = Microbenchmark::RunAll(options);
+
+        std::ofstream file{ outPath, std::ios::trunc };
+        if (!file) {
+            throw std::runtime_error("Failed to open " + outPath);
+        }
+        Microbenchmark::WriteJson(file, results);
+        std::cout << "microbenchmark: wrote " << results.size() << " results to " << outPath << std::endl;
+
+        if (!baselinePath.empty() && !Microbenchmark::CompareToBaseline(results, baseline, threshold)) {
+            return EXIT_FAILURE;
+        }
+    }
+    catch (std::exception& e) {
+        std::cerr << e.what() << '\n';
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Core/Model.h>
+#include <Core/Scene.h>
+
+#include <memory>
+
+struct TransformComponent {
+    glm::vec3 translation{};
+    glm::vec3 scale{ 1.0f, 1.0f, 1.0f };
+    glm::vec3 rotation{};
+
+    glm::mat4 mat4() const;
+    glm::mat3 NormalMatrix() const;
+};
+
+// Links into the transform hierarchy. Children of one parent form a doubly linked list,
+// depth is 0 for roots. Only TransformSystem writes these.
+struct HierarchyComponent {
+    Entity   parent{};
+    Entity   firstChild{};
+    Entity   prevSibling{};
+    Entity   nextSibling{};
+    uint32_t depth = 0;
+};
+
+// Matrices cached by TransformSystem::Update(). local comes from the TransformComponent,
+// world is parent world * local. maxScale bounds how much world stretches
+// any direction, for bounding spheres.
+struct WorldTransformComponent {
+    glm::mat4 local{ 1.0f };
+    glm::mat4 localNormal{ 1.0f };
+    glm::mat4 world{ 1.0f };
+    glm::mat4 normal{ 1.0f };
+    float     maxScale = 1.0f;
+    bool      dirty = true;
+};
+
+struct MeshComponent {
+    std::shared_ptr<Model> model{};
+};
+
+struct ColorComponent {
+    glm::vec3 color{};
+};
+
+// World space bounding sphere, xyz center and w radius. Written by the render system's
+// cull pass, so other systems can query it without touching the model.
+struct BoundsComponent {
+    glm::vec4 sphere{ 0.0f };
+};
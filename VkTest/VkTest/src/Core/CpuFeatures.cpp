@@ -0,0 +1,43 @@
+#include "CpuFeatures.h"
+
+#if VKTEST_X86 && defined(_MSC_VER)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+static CpuFeatures QueryCpuFeatures() {
+    CpuFeatures features{};
+
+#if VKTEST_X86 && defined(_MSC_VER)
+    int info[4]{};
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    features.sse41 = (info[2] & (1 << 19)) != 0;
+    features.fma = (info[2] & (1 << 12)) != 0;
+
+    // The OS has to save the upper halves of the ymm registers, otherwise AVX is unusable
+    const bool ymmEnabled = osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+    features.fma = features.fma && ymmEnabled;
+
+    if (maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        features.avx2 = ymmEnabled && (info[1] & (1 << 5)) != 0;
+    }
+#elif VKTEST_X86
+    __builtin_cpu_init();
+    features.sse41 = __builtin_cpu_supports("sse4.1");
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.fma = __builtin_cpu_supports("fma");
+#endif
+
+    return features;
+}
+
+const CpuFeatures& CpuFeatures::Get() {
+    static const CpuFeatures features = QueryCpuFeatures();
+    return features;
+}
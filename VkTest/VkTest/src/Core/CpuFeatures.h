@@ -0,0 +1,23 @@
+#pragma once
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define VKTEST_X86 1
+#else
+#define VKTEST_X86 0
+#endif
+
+// MSVC emits any intrinsic regardless of /arch, GCC and Clang need the target per function
+#if VKTEST_X86 && !defined(_MSC_VER)
+#define VKTEST_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#else
+#define VKTEST_TARGET_AVX2
+#endif
+
+// Instruction sets usable on this machine, queried once. SIMD kernels pick their path from it.
+struct CpuFeatures {
+    bool sse41 = false;
+    bool avx2 = false;
+    bool fma = false;
+
+    static const CpuFeatures& Get();
+};
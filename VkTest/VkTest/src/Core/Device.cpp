@@ -1,4 +1,6 @@
 #include "Device.h"
+#include <Core/PipelineManager.h>
+#include <Core/Trace.h>
 
 #include <cstring>
 #include <iostream>
@@ -43,24 +45,42 @@ void DestroyDebugUtilsMessengerEXT(
 }
 
 Device::Device(Window &window) 
-        : m_Window{window} {
+        : m_pWindow{&window}, m_DeviceExtensions{VK_KHR_SWAPCHAIN_EXTENSION_NAME} {
+    Init();
+}
+
+Device::Device() {
+    Init();
+}
+
+void Device::Init() {
     CreateInstance();
     SetupDebugMessenger();
     CreateSurface();
     PickPhysicalDevice();
     CreateLogicalDevice();
     CreateCommandPool();
+    m_pUploadManager = std::make_unique<UploadManager>(*this);
+    m_pPipelineCache = std::make_unique<PipelineCache>(m_Device_, properties, s_PipelineCachePath);
+    m_pPipelineManager = std::make_unique<PipelineManager>(*this);
 }
 
 Device::~Device() {
+    m_pPipelineManager.reset();
+    m_pPipelineCache.reset();
+    m_GeometryPools.clear();
+    m_pUploadManager.reset();
     vkDestroyCommandPool(m_Device_, m_CommandPool, nullptr);
+    m_pAllocator.reset();
     vkDestroyDevice(m_Device_, nullptr);
     
     if (enableValidationLayers) {
         DestroyDebugUtilsMessengerEXT(m_Instance, m_DebugMessenger, nullptr);
     }
     
-    vkDestroySurfaceKHR(m_Instance, m_Surface_, nullptr);
+    if (m_Surface_ != VK_NULL_HANDLE) {
+        vkDestroySurfaceKHR(m_Instance, m_Surface_, nullptr);
+    }
     vkDestroyInstance(m_Instance, nullptr);
 }
 
@@ -134,6 +154,9 @@ void Device::CreateLogicalDevice() {
     
     std::vector<VkDeviceQueueCreateInfo> queueCreateInfos;
     std::set<uint32_t> uniqueQueueFamilies = {indices.m_GraphicsFamily, indices.m_PresentFamily };
+    if (indices.m_TransferFamilyHasValue) {
+        uniqueQueueFamilies.insert(indices.m_TransferFamily);
+    }
     
     float queuePriority = 1.0f;
     for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -145,8 +168,25 @@ void Device::CreateLogicalDevice() {
         queueCreateInfos.push_back(queueCreateInfo);
     }
     
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &supportedFeatures);
+    
     VkPhysicalDeviceFeatures deviceFeatures = {};
-    deviceFeatures.samplerAnisotropy = VK_TRUE;
+    // Optional, nothing samples with anisotropy yet and software rasterizers may lack it
+    deviceFeatures.samplerAnisotropy = supportedFeatures.samplerAnisotropy;
+    // Optional, only the indirect render path depends on them
+    deviceFeatures.multiDrawIndirect = supportedFeatures.multiDrawIndirect;
+    deviceFeatures.drawIndirectFirstInstance = supportedFeatures.drawIndirectFirstInstance;
+    // Optional, only the GPU profiler depends on them
+    deviceFeatures.pipelineStatisticsQuery = supportedFeatures.pipelineStatisticsQuery;
+    deviceFeatures.inheritedQueries = supportedFeatures.inheritedQueries;
+    m_EnabledFeatures = deviceFeatures;
+    
+    std::vector<const char *> enabledExtensions = m_DeviceExtensions;
+    m_DrawIndirectCountSupported = IsExtensionAvailable(m_PhysicalDevice, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    if (m_DrawIndirectCountSupported) {
+        enabledExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    }
     
     VkDeviceCreateInfo createInfo = {};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -155,8 +195,8 @@ void Device::CreateLogicalDevice() {
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     
     createInfo.pEnabledFeatures = &deviceFeatures;
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(m_DeviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = m_DeviceExtensions.data();
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(enabledExtensions.size());
+    createInfo.ppEnabledExtensionNames = enabledExtensions.data();
     
     if (enableValidationLayers) {
         createInfo.enabledLayerCount = static_cast<uint32_t>(m_ValidationLayers.size());
@@ -171,6 +211,18 @@ void Device::CreateLogicalDevice() {
     
     vkGetDeviceQueue(m_Device_, indices.m_GraphicsFamily, 0, &m_GraphicsQueue_);
     vkGetDeviceQueue(m_Device_, indices.m_PresentFamily, 0, &m_PresentQueue_);
+    
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice, &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice, &queueFamilyCount, queueFamilies.data());
+    m_TimestampValidBits = queueFamilies[indices.m_GraphicsFamily].timestampValidBits;
+    
+    // Without a transfer-only family uploads share the graphics queue and need no ownership transfers
+    m_TransferFamily_ = indices.m_TransferFamilyHasValue ? indices.m_TransferFamily : indices.m_GraphicsFamily;
+    vkGetDeviceQueue(m_Device_, m_TransferFamily_, 0, &m_TransferQueue_);
+
+    m_pAllocator = std::make_unique<MemoryAllocator>(m_Device_, m_PhysicalDevice);
 }
 
 void Device::CreateCommandPool() {
@@ -187,24 +239,25 @@ void Device::CreateCommandPool() {
     }
 }
 
-void Device::CreateSurface() { m_Window.CreateWindowSurface(m_Instance, &m_Surface_); }
+void Device::CreateSurface() {
+    if (m_pWindow != nullptr) {
+        m_pWindow->CreateWindowSurface(m_Instance, &m_Surface_);
+    }
+}
 
 bool Device::IsDeviceSuitable(VkPhysicalDevice device) {
     QueueFamilyIndices indices = FindQueueFamilies(device);
     
     bool extensionsSupported = CheckDeviceExtensionSupport(device);
     
-    bool swapChainAdequate = false;
-    if (extensionsSupported) {
+    // Headless there is nothing to present to
+    bool swapChainAdequate = IsHeadless();
+    if (extensionsSupported && !IsHeadless()) {
         SwapChainSupportDetails swapChainSupport = QuerySwapChainSupport(device);
         swapChainAdequate = !swapChainSupport.m_Formats.empty() && !swapChainSupport.m_PresentModes.empty();
     }
     
-    VkPhysicalDeviceFeatures supportedFeatures;
-    vkGetPhysicalDeviceFeatures(device, &supportedFeatures);
-    
-    return indices.IsComplete() && extensionsSupported && swapChainAdequate &&
-         supportedFeatures.samplerAnisotropy;
+    return indices.IsComplete() && extensionsSupported && swapChainAdequate;
 }
 
 void Device::PopulateDebugMessengerCreateInfo(
@@ -255,11 +308,15 @@ bool Device::CheckValidationLayerSupport() {
 }
 
 std::vector<const char *> Device::GetRequiredExtensions() {
-    uint32_t glfwExtensionCount = 0;
-    const char **glfwExtensions;
-    glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-    
-    std::vector<const char *> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    std::vector<const char *> extensions;
+    
+    // GLFW is never initialized headless, and surface extensions may not even exist there
+    if (!IsHeadless()) {
+        uint32_t glfwExtensionCount = 0;
+        const char **glfwExtensions;
+        glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+        extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    }
     
     if (enableValidationLayers) {
         extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -311,6 +368,26 @@ bool Device::CheckDeviceExtensionSupport(VkPhysicalDevice device) {
     return requiredExtensions.empty();
 }
 
+bool Device::IsExtensionAvailable(VkPhysicalDevice device, const char *extensionName) {
+    uint32_t extensionCount;
+    vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+    
+    std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(
+            device,
+            nullptr,
+            &extensionCount,
+            availableExtensions.data());
+    
+    for (const auto &extension : availableExtensions) {
+        if (strcmp(extension.extensionName, extensionName) == 0) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
 QueueFamilyIndices Device::FindQueueFamilies(VkPhysicalDevice device) {
     QueueFamilyIndices indices;
     
@@ -326,8 +403,11 @@ QueueFamilyIndices Device::FindQueueFamilies(VkPhysicalDevice device) {
             indices.m_GraphicsFamily = i;
             indices.m_GraphicsFamilyHasValue = true;
         }
-        VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface_, &presentSupport);
+        // Headless the graphics family stands in for present, which is never used
+        VkBool32 presentSupport = IsHeadless() && indices.m_GraphicsFamilyHasValue;
+        if (!IsHeadless()) {
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_Surface_, &presentSupport);
+        }
         if (queueFamily.queueCount > 0 && presentSupport) {
             indices.m_PresentFamily = i;
             indices.m_PresentFamilyHasValue = true;
@@ -339,6 +419,22 @@ QueueFamilyIndices Device::FindQueueFamilies(VkPhysicalDevice device) {
         i++;
     }
     
+    // Prefer a pure DMA family, otherwise settle for an async compute family
+    for (uint32_t pass = 0; pass < 2 && !indices.m_TransferFamilyHasValue; pass++) {
+        for (uint32_t j = 0; j < queueFamilyCount; j++) {
+            const VkQueueFlags flags = queueFamilies[j].queueFlags;
+            const bool isTransferOnly = (flags & VK_QUEUE_TRANSFER_BIT) &&
+                !(flags & VK_QUEUE_GRAPHICS_BIT) &&
+                (pass == 1 || !(flags & VK_QUEUE_COMPUTE_BIT));
+            
+            if (queueFamilies[j].queueCount > 0 && isTransferOnly) {
+                indices.m_TransferFamily = j;
+                indices.m_TransferFamilyHasValue = true;
+                break;
+            }
+        }
+    }
+    
     return indices;
 }
 
@@ -387,16 +483,7 @@ VkFormat Device::FindSupportedFormat(
 }
 
 uint32_t Device::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) {
-    VkPhysicalDeviceMemoryProperties memProperties;
-    vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &memProperties);
-    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
-        if ((typeFilter & (1 << i)) &&
-            (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
-            return i;
-        }
-    }
-    
-    throw std::runtime_error("failed to find suitable memory type!");
+    return m_pAllocator->FindMemoryType(typeFilter, properties);
 }
 
 void Device::CreateBuffer(
@@ -404,7 +491,7 @@ void Device::CreateBuffer(
         VkBufferUsageFlags usage,
         VkMemoryPropertyFlags properties,
         VkBuffer &buffer,
-        VkDeviceMemory &bufferMemory) {
+        MemoryAllocation &bufferMemory) {
     VkBufferCreateInfo bufferInfo{};
     bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
     bufferInfo.size = size;
@@ -418,16 +505,14 @@ void Device::CreateBuffer(
     VkMemoryRequirements memRequirements;
     vkGetBufferMemoryRequirements(m_Device_, buffer, &memRequirements);
     
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties);
+    bufferMemory = m_pAllocator->Allocate(memRequirements, properties, true);
     
-    if (vkAllocateMemory(m_Device_, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate vertex buffer memory!");
-    }
-    
-    vkBindBufferMemory(m_Device_, buffer, bufferMemory, 0);
+    vkBindBufferMemory(m_Device_, buffer, bufferMemory.memory, bufferMemory.offset);
+}
+
+void Device::DestroyBuffer(VkBuffer buffer, MemoryAllocation &bufferMemory) {
+    vkDestroyBuffer(m_Device_, buffer, nullptr);
+    m_pAllocator->Free(bufferMemory);
 }
 
 VkCommandBuffer Device::BeginSingleTimeCommands() {
@@ -449,6 +534,7 @@ VkCommandBuffer Device::BeginSingleTimeCommands() {
 }
 
 void Device::EndSingleTimeCommands(VkCommandBuffer commandBuffer) {
+    TRACE_ZONE("Device::EndSingleTimeCommands");
     vkEndCommandBuffer(commandBuffer);
     
     VkSubmitInfo submitInfo{};
@@ -510,7 +596,7 @@ void Device::CreateImageWithInfo(
         const VkImageCreateInfo &imageInfo,
         VkMemoryPropertyFlags properties,
         VkImage &image,
-        VkDeviceMemory &imageMemory) {
+        MemoryAllocation &imageMemory) {
     if (vkCreateImage(m_Device_, &imageInfo, nullptr, &image) != VK_SUCCESS) {
         throw std::runtime_error("failed to create image!");
     }
@@ -518,16 +604,25 @@ void Device::CreateImageWithInfo(
     VkMemoryRequirements memRequirements;
     vkGetImageMemoryRequirements(m_Device_, image, &memRequirements);
     
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memRequirements.size;
-    allocInfo.memoryTypeIndex = FindMemoryType(memRequirements.memoryTypeBits, properties);
+    imageMemory = m_pAllocator->Allocate(memRequirements, properties, imageInfo.tiling == VK_IMAGE_TILING_LINEAR);
     
-    if (vkAllocateMemory(m_Device_, &allocInfo, nullptr, &imageMemory) != VK_SUCCESS) {
-        throw std::runtime_error("failed to allocate image memory!");
+    if (vkBindImageMemory(m_Device_, image, imageMemory.memory, imageMemory.offset) != VK_SUCCESS) {
+        throw std::runtime_error("failed to bind image memory!");
     }
+}
+
+GeometryPool& Device::GetGeometryPool(uint32_t vertexStride) {
+    std::lock_guard<std::mutex> lock{ m_GeometryPoolMutex };
     
-    if (vkBindImageMemory(m_Device_, image, imageMemory, 0) != VK_SUCCESS) {
-        throw std::runtime_error("failed to bind image memory!");
+    auto& pool = m_GeometryPools[vertexStride];
+    if (!pool) {
+        pool = std::make_unique<GeometryPool>(*this, vertexStride);
     }
+    
+    return *pool;
+}
+
+void Device::DestroyImage(VkImage image, MemoryAllocation &imageMemory) {
+    vkDestroyImage(m_Device_, image, nullptr);
+    m_pAllocator->Free(imageMemory);
 }
\ No newline at end of file
@@ -1,10 +1,19 @@
 #pragma once
 
 #include "Window.h"
+#include "GeometryPool.h"
+#include "MemoryAllocator.h"
+#include "PipelineCache.h"
+#include "UploadManager.h"
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+class PipelineManager;
+
 struct SwapChainSupportDetails {
     VkSurfaceCapabilitiesKHR        m_Capabilities;
     std::vector<VkSurfaceFormatKHR> m_Formats;
@@ -17,18 +26,23 @@ public:
 public:
     uint32_t    m_GraphicsFamily;
     uint32_t    m_PresentFamily;
+    uint32_t    m_TransferFamily;
     bool        m_GraphicsFamilyHasValue = false;
     bool        m_PresentFamilyHasValue = false;
+    bool        m_TransferFamilyHasValue = false; // only set for a family without graphics
 };
 
 class Device {
 public:
+    static constexpr const char* s_PipelineCachePath = "pipeline_cache.bin";
 #ifdef NDEBUG
     const bool enableValidationLayers = false;
 #else
     const bool enableValidationLayers = true;
 #endif
     Device(Window &window);
+    // Headless, no surface or swap chain, for rendering offscreen on machines without a display
+    Device();
     ~Device();
 
     Device(const Device &) = delete;
@@ -41,6 +55,10 @@ public:
     VkSurfaceKHR Surface() { return m_Surface_; }
     VkQueue GraphicsQueue() { return m_GraphicsQueue_; }
     VkQueue PresentQueue() { return m_PresentQueue_; }
+    VkQueue TransferQueue() { return m_TransferQueue_; }
+    uint32_t TransferFamily() { return m_TransferFamily_; }
+    bool HasDedicatedTransferQueue() { return m_TransferQueue_ != m_GraphicsQueue_; }
+    bool IsHeadless() const { return m_pWindow == nullptr; }
     
     SwapChainSupportDetails GetSwapChainSupport() { return QuerySwapChainSupport(m_PhysicalDevice); }
     uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
@@ -55,7 +73,8 @@ public:
             VkBufferUsageFlags usage,
             VkMemoryPropertyFlags properties,
             VkBuffer &buffer,
-            VkDeviceMemory &bufferMemory);
+            MemoryAllocation &bufferMemory);
+    void DestroyBuffer(VkBuffer buffer, MemoryAllocation &bufferMemory);
 
     VkCommandBuffer BeginSingleTimeCommands();
     void EndSingleTimeCommands(VkCommandBuffer commandBuffer);
@@ -66,10 +85,25 @@ public:
         const VkImageCreateInfo &imageInfo,
         VkMemoryPropertyFlags properties,
         VkImage &image,
-        VkDeviceMemory &imageMemory);
+        MemoryAllocation &imageMemory);
+    void DestroyImage(VkImage image, MemoryAllocation &imageMemory);
+
+    MemoryAllocator& GetAllocator() { return *m_pAllocator; }
+    UploadManager& GetUploadManager() { return *m_pUploadManager; }
+    // Shared by every pipeline, persisted to s_PipelineCachePath on shutdown
+    VkPipelineCache GetPipelineCache() { return m_pPipelineCache->GetCache(); }
+    PipelineManager& GetPipelineManager() { return *m_pPipelineManager; }
+    // Shared vertex/index storage, one pool per vertex layout
+    GeometryPool& GetGeometryPool(uint32_t vertexStride);
+    
+    const VkPhysicalDeviceFeatures& GetEnabledFeatures() const { return m_EnabledFeatures; }
+    bool SupportsDrawIndirectCount() const { return m_DrawIndirectCountSupported; }
+    // 0 when the graphics queue cannot write timestamps
+    uint32_t GetTimestampValidBits() const { return m_TimestampValidBits; }
 public:
     VkPhysicalDeviceProperties properties;
 private:
+    void Init();
     void CreateInstance();
     void SetupDebugMessenger();
     void CreateSurface();
@@ -84,19 +118,32 @@ private:
     void PopulateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT &createInfo);
     void HasGflwRequiredInstanceExtensions();
     bool CheckDeviceExtensionSupport(VkPhysicalDevice device);
+    bool IsExtensionAvailable(VkPhysicalDevice device, const char *extensionName);
     SwapChainSupportDetails QuerySwapChainSupport(VkPhysicalDevice device);
 private:
     VkInstance                      m_Instance;
     VkDebugUtilsMessengerEXT        m_DebugMessenger;
     VkPhysicalDevice                m_PhysicalDevice = VK_NULL_HANDLE;
-    Window&                         m_Window;
+    Window*                         m_pWindow = nullptr;
     VkCommandPool                   m_CommandPool;
                                     
     VkDevice                        m_Device_;
-    VkSurfaceKHR                    m_Surface_;
+    VkSurfaceKHR                    m_Surface_ = VK_NULL_HANDLE;
     VkQueue                         m_GraphicsQueue_;
     VkQueue                         m_PresentQueue_;
+    VkQueue                         m_TransferQueue_;
+    uint32_t                        m_TransferFamily_;
+    std::unique_ptr<MemoryAllocator> m_pAllocator;
+    std::unique_ptr<UploadManager>  m_pUploadManager;
+    std::unique_ptr<PipelineCache>  m_pPipelineCache;
+    std::unique_ptr<PipelineManager> m_pPipelineManager;
+    std::unordered_map<uint32_t, std::unique_ptr<GeometryPool>> m_GeometryPools;
+    std::mutex                      m_GeometryPoolMutex;
+    
+    VkPhysicalDeviceFeatures        m_EnabledFeatures{};
+    bool                            m_DrawIndirectCountSupported = false;
+    uint32_t                        m_TimestampValidBits = 0;
     
     const std::vector<const char *> m_ValidationLayers = {"VK_LAYER_KHRONOS_validation"};
-    const std::vector<const char *> m_DeviceExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
+    std::vector<const char *>       m_DeviceExtensions;
 };
\ No newline at end of file
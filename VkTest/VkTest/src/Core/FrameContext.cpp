@@ -0,0 +1,62 @@
+#include "FrameContext.h"
+
+#include <stdexcept>
+
+FrameContext::FrameContext(Device& device, uint32_t recorderCount)
+    : m_Device{ device }, m_Recorders(recorderCount) {
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+    poolInfo.queueFamilyIndex = m_Device.FindPhysicalQueueFamilies().m_GraphicsFamily;
+
+    for (auto& recorder : m_Recorders) {
+        if (vkCreateCommandPool(m_Device.GetDevice(), &poolInfo, nullptr, &recorder.commandPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create command pool!");
+        }
+    }
+}
+
+FrameContext::~FrameContext() {
+    // Destroying a pool frees every buffer allocated from it
+    for (auto& recorder : m_Recorders) {
+        vkDestroyCommandPool(m_Device.GetDevice(), recorder.commandPool, nullptr);
+    }
+}
+
+void FrameContext::Reset() {
+    for (auto& recorder : m_Recorders) {
+        if (recorder.usedPrimary == 0 && recorder.usedSecondary == 0) {
+            continue;
+        }
+
+        if (vkResetCommandPool(m_Device.GetDevice(), recorder.commandPool, 0) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to reset command pool!");
+        }
+        recorder.usedPrimary = 0;
+        recorder.usedSecondary = 0;
+    }
+}
+
+VkCommandBuffer FrameContext::AllocateCommandBuffer(VkCommandBufferLevel level, uint32_t recorder) {
+    auto& slot = m_Recorders.at(recorder);
+    const bool primary = level == VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    auto& buffers = primary ? slot.primaryBuffers : slot.secondaryBuffers;
+    auto& used = primary ? slot.usedPrimary : slot.usedSecondary;
+
+    // A pool reset puts its buffers back into the initial state, so they are simply reused
+    if (used == buffers.size()) {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = level;
+        allocInfo.commandPool = slot.commandPool;
+        allocInfo.commandBufferCount = 1;
+
+        VkCommandBuffer commandBuffer;
+        if (vkAllocateCommandBuffers(m_Device.GetDevice(), &allocInfo, &commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate commad buffers!");
+        }
+        buffers.push_back(commandBuffer);
+    }
+
+    return buffers[used++];
+}
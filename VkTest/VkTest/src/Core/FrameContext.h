@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Core/Device.h>
+
+#include <cstdint>
+#include <vector>
+
+// Command buffer storage for one frame in flight. Buffers are handed out from transient
+// pools and never freed one by one; Reset() recycles a whole pool with vkResetCommandPool
+// once the frame's fence has signalled. Every recorder slot has its own pool, so threads
+// recording into different slots never contend. Slot 0 belongs to the main thread.
+class FrameContext {
+public:
+    FrameContext(Device& device, uint32_t recorderCount);
+    ~FrameContext();
+
+    FrameContext(const FrameContext&) = delete;
+    FrameContext& operator=(const FrameContext&) = delete;
+
+    FrameContext(FrameContext&&) = delete;
+    FrameContext& operator=(FrameContext&&) = delete;
+public:
+    // Only valid once the GPU is done with everything recorded since the last Reset()
+    void Reset();
+    // Not synchronized, a slot must only be used by one thread at a time
+    VkCommandBuffer AllocateCommandBuffer(VkCommandBufferLevel level, uint32_t recorder = 0);
+
+    uint32_t GetRecorderCount() const { return static_cast<uint32_t>(m_Recorders.size()); }
+private:
+    struct Recorder {
+        VkCommandPool                   commandPool = VK_NULL_HANDLE;
+        std::vector<VkCommandBuffer>    primaryBuffers;
+        std::vector<VkCommandBuffer>    secondaryBuffers;
+        uint32_t                        usedPrimary = 0;
+        uint32_t                        usedSecondary = 0;
+    };
+private:
+    Device&                 m_Device;
+    std::vector<Recorder>   m_Recorders;
+};
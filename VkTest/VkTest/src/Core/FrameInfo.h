@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Core/Camera.h>
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+
+class FrameContext;
+
+// Filled in by the render system while recording
+struct FrameStats {
+    uint32_t objectCount = 0;       // objects with a model that has finished streaming in
+    uint32_t culledCount = 0;       // rejected by the CPU frustum test before recording
+    uint32_t drawCount = 0;         // draw calls recorded
+    uint32_t geometryBindCount = 0; // vertex/index buffer binds recorded
+};
+
+struct FrameInfo {
+    uint32_t        frameIndex;
+    float           frameTime;
+    VkCommandBuffer commandBuffer;
+    Camera&         camera;
+    VkExtent2D      extent{};
+    FrameContext*   frameContext = nullptr;     // extra command buffers for this frame
+    FrameStats      stats{};
+};
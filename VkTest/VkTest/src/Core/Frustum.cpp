@@ -0,0 +1,158 @@
+#include "Frustum.h"
+#include <Core/CpuFeatures.h>
+
+#if VKTEST_X86
+#include <immintrin.h>
+#endif
+
+// Gribb/Hartmann with a [0, 1] depth range, planes point inwards and are normalized
+Frustum::Frustum(const glm::mat4& projectionView) {
+    glm::vec4 rows[4];
+    for (int i = 0; i < 4; i++) {
+        rows[i] = glm::vec4{ projectionView[0][i], projectionView[1][i], projectionView[2][i], projectionView[3][i] };
+    }
+
+    m_Planes[0] = rows[3] + rows[0];
+    m_Planes[1] = rows[3] - rows[0];
+    m_Planes[2] = rows[3] + rows[1];
+    m_Planes[3] = rows[3] - rows[1];
+    m_Planes[4] = rows[2];
+    m_Planes[5] = rows[3] - rows[2];
+
+    for (int i = 0; i < 6; i++) {
+        m_Planes[i] /= glm::length(glm::vec3{ m_Planes[i] });
+    }
+}
+
+void Frustum::CullSpheres(
+        const float* centerX,
+        const float* centerY,
+        const float* centerZ,
+        const float* radius,
+        size_t count,
+        uint8_t* visible) const {
+#if VKTEST_X86
+    if (CpuFeatures::Get().avx2) {
+        CullSpheresAvx2(centerX, centerY, centerZ, radius, count, visible);
+        return;
+    }
+    // SSE2 is part of x64, the 4 wide path needs nothing more
+    CullSpheresSse(centerX, centerY, centerZ, radius, count, visible);
+#else
+    CullSpheresScalar(centerX, centerY, centerZ, radius, 0, count, visible);
+#endif
+}
+
+void Frustum::CullSpheresScalar(
+        const float* x,
+        const float* y,
+        const float* z,
+        const float* r,
+        size_t begin,
+        size_t end,
+        uint8_t* visible) const {
+    for (size_t i = begin; i < end; i++) {
+        bool inside = true;
+        for (int p = 0; p < 6; p++) {
+            const glm::vec4& plane = m_Planes[p];
+            const float distance = plane.x * x[i] + plane.y * y[i] + plane.z * z[i] + plane.w;
+            inside = inside && distance > -r[i];
+        }
+        visible[i] = inside ? 1 : 0;
+    }
+}
+
+#if VKTEST_X86
+
+void Frustum::CullSpheresSse(
+        const float* x,
+        const float* y,
+        const float* z,
+        const float* r,
+        size_t count,
+        uint8_t* visible) const {
+    __m128 planeX[6], planeY[6], planeZ[6], planeW[6];
+    for (int p = 0; p < 6; p++) {
+        planeX[p] = _mm_set1_ps(m_Planes[p].x);
+        planeY[p] = _mm_set1_ps(m_Planes[p].y);
+        planeZ[p] = _mm_set1_ps(m_Planes[p].z);
+        planeW[p] = _mm_set1_ps(m_Planes[p].w);
+    }
+
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const size_t wideCount = count & ~size_t(3);
+    for (size_t i = 0; i < wideCount; i += 4) {
+        const __m128 cx = _mm_loadu_ps(x + i);
+        const __m128 cy = _mm_loadu_ps(y + i);
+        const __m128 cz = _mm_loadu_ps(z + i);
+        const __m128 negRadius = _mm_xor_ps(_mm_loadu_ps(r + i), signMask);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; p++) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(planeX[p], cx), planeW[p]);
+            distance = _mm_add_ps(_mm_mul_ps(planeY[p], cy), distance);
+            distance = _mm_add_ps(_mm_mul_ps(planeZ[p], cz), distance);
+            inside = _mm_and_ps(inside, _mm_cmpgt_ps(distance, negRadius));
+        }
+
+        const int mask = _mm_movemask_ps(inside);
+        for (int lane = 0; lane < 4; lane++) {
+            visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+        }
+    }
+
+    CullSpheresScalar(x, y, z, r, wideCount, count, visible);
+}
+
+VKTEST_TARGET_AVX2
+void Frustum::CullSpheresAvx2(
+        const float* x,
+        const float* y,
+        const float* z,
+        const float* r,
+        size_t count,
+        uint8_t* visible) const {
+    __m256 planeX[6], planeY[6], planeZ[6], planeW[6];
+    for (int p = 0; p < 6; p++) {
+        planeX[p] = _mm256_set1_ps(m_Planes[p].x);
+        planeY[p] = _mm256_set1_ps(m_Planes[p].y);
+        planeZ[p] = _mm256_set1_ps(m_Planes[p].z);
+        planeW[p] = _mm256_set1_ps(m_Planes[p].w);
+    }
+
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const size_t wideCount = count & ~size_t(7);
+    for (size_t i = 0; i < wideCount; i += 8) {
+        const __m256 cx = _mm256_loadu_ps(x + i);
+        const __m256 cy = _mm256_loadu_ps(y + i);
+        const __m256 cz = _mm256_loadu_ps(z + i);
+        const __m256 negRadius = _mm256_xor_ps(_mm256_loadu_ps(r + i), signMask);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; p++) {
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(planeX[p], cx), planeW[p]);
+            distance = _mm256_add_ps(_mm256_mul_ps(planeY[p], cy), distance);
+            distance = _mm256_add_ps(_mm256_mul_ps(planeZ[p], cz), distance);
+            inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negRadius, _CMP_GT_OQ));
+        }
+
+        const int mask = _mm256_movemask_ps(inside);
+        for (int lane = 0; lane < 8; lane++) {
+            visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+        }
+    }
+
+    CullSpheresScalar(x, y, z, r, wideCount, count, visible);
+}
+
+#else
+
+void Frustum::CullSpheresSse(const float* x, const float* y, const float* z, const float* r, size_t count, uint8_t* visible) const {
+    CullSpheresScalar(x, y, z, r, 0, count, visible);
+}
+
+void Frustum::CullSpheresAvx2(const float* x, const float* y, const float* z, const float* r, size_t count, uint8_t* visible) const {
+    CullSpheresScalar(x, y, z, r, 0, count, visible);
+}
+
+#endif
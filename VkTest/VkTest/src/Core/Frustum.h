@@ -0,0 +1,32 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+// View frustum as six inward facing, normalized planes (xyz normal, w distance)
+class Frustum {
+public:
+    explicit Frustum(const glm::mat4& projectionView);
+public:
+    // Spheres are given as separate x/y/z/radius streams so that 4 or 8 of them fit into
+    // one register. visible[i] is set to 1 when sphere i touches the frustum, 0 otherwise.
+    void CullSpheres(
+        const float* centerX,
+        const float* centerY,
+        const float* centerZ,
+        const float* radius,
+        size_t count,
+        uint8_t* visible) const;
+
+    const glm::vec4* GetPlanes() const { return m_Planes; }
+private:
+    void CullSpheresScalar(const float* x, const float* y, const float* z, const float* r, size_t begin, size_t end, uint8_t* visible) const;
+    void CullSpheresSse(const float* x, const float* y, const float* z, const float* r, size_t count, uint8_t* visible) const;
+    void CullSpheresAvx2(const float* x, const float* y, const float* z, const float* r, size_t count, uint8_t* visible) const;
+private:
+    glm::vec4 m_Planes[6];
+};
@@ -0,0 +1,201 @@
+#include "GeometryPool.h"
+
+#include <Core/Device.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+GeometryPool::GeometryPool(Device& device, uint32_t vertexStride)
+    : m_Device{ device }, m_VertexStride{ vertexStride } {
+    CreatePage(s_PageVertexCapacity, s_PageIndexCapacity);
+}
+
+GeometryPool::~GeometryPool() {
+    for (auto& page : m_Pages) {
+        m_Device.DestroyBuffer(page->vertexBuffer, page->vertexMemory);
+        m_Device.DestroyBuffer(page->indexBuffer, page->indexMemory);
+    }
+}
+
+GeometryRange GeometryPool::Allocate(uint32_t vertexCount, uint32_t indexCount, VkIndexType indexType) {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    GeometryRange range{};
+    range.vertexCount = vertexCount;
+    range.indexCount = indexCount;
+    range.indexType = indexType;
+
+    const uint32_t indexUnits = GetIndexUnits(indexCount, indexType);
+    const uint32_t unitsPerIndex = GetIndexSize(indexType) / sizeof(uint16_t);
+
+    uint32_t vertexOffset = 0;
+    uint32_t indexOffset = 0;
+    for (uint32_t i = 0; i < m_Pages.size(); i++) {
+        Page& page = *m_Pages[i];
+        if (!TakeSpan(page.freeVertices, vertexCount, vertexOffset)) {
+            continue;
+        }
+        if (!TakeSpan(page.freeIndices, indexUnits, indexOffset)) {
+            ReturnSpan(page.freeVertices, vertexOffset, vertexCount);
+            continue;
+        }
+
+        range.vertexOffset = static_cast<int32_t>(vertexOffset);
+        range.firstIndex = indexOffset / unitsPerIndex;
+        range.page = i;
+        return range;
+    }
+
+    // Oversized meshes get a page of their own size
+    Page& page = CreatePage(
+        std::max(vertexCount, s_PageVertexCapacity),
+        std::max(indexUnits / 2, s_PageIndexCapacity));
+    TakeSpan(page.freeVertices, vertexCount, vertexOffset);
+    TakeSpan(page.freeIndices, indexUnits, indexOffset);
+
+    range.vertexOffset = static_cast<int32_t>(vertexOffset);
+    range.firstIndex = indexOffset / unitsPerIndex;
+    range.page = static_cast<uint32_t>(m_Pages.size() - 1);
+    return range;
+}
+
+void GeometryPool::Free(const GeometryRange& range) {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    const VkDeviceSize indexSize = GetIndexSize(range.indexType);
+    const uint32_t unitsPerIndex = static_cast<uint32_t>(indexSize / sizeof(uint16_t));
+
+    Page& page = *m_Pages[range.page];
+
+    // Before the spans can be handed out again
+    auto& uploadManager = m_Device.GetUploadManager();
+    uploadManager.DiscardAcquires(
+        page.vertexBuffer,
+        static_cast<VkDeviceSize>(range.vertexOffset) * m_VertexStride,
+        static_cast<VkDeviceSize>(range.vertexCount) * m_VertexStride);
+    uploadManager.DiscardAcquires(
+        page.indexBuffer,
+        static_cast<VkDeviceSize>(range.firstIndex) * indexSize,
+        static_cast<VkDeviceSize>(range.indexCount) * indexSize);
+
+    ReturnSpan(page.freeVertices, static_cast<uint32_t>(range.vertexOffset), range.vertexCount);
+    ReturnSpan(page.freeIndices, range.firstIndex * unitsPerIndex, GetIndexUnits(range.indexCount, range.indexType));
+}
+
+UploadManager::Ticket GeometryPool::Upload(const GeometryRange& range, const void* vertices, const void* indices) {
+    VkBuffer vertexBuffer;
+    VkBuffer indexBuffer;
+    {
+        std::lock_guard<std::mutex> lock{ m_Mutex };
+        vertexBuffer = m_Pages[range.page]->vertexBuffer;
+        indexBuffer = m_Pages[range.page]->indexBuffer;
+    }
+
+    auto& uploadManager = m_Device.GetUploadManager();
+    const VkDeviceSize indexSize = GetIndexSize(range.indexType);
+
+    uploadManager.UploadBuffer(
+        vertexBuffer,
+        static_cast<VkDeviceSize>(range.vertexOffset) * m_VertexStride,
+        vertices,
+        static_cast<VkDeviceSize>(range.vertexCount) * m_VertexStride);
+
+    return uploadManager.UploadBuffer(
+        indexBuffer,
+        static_cast<VkDeviceSize>(range.firstIndex) * indexSize,
+        indices,
+        static_cast<VkDeviceSize>(range.indexCount) * indexSize);
+}
+
+void GeometryPool::Bind(VkCommandBuffer commandBuffer, uint32_t page, VkIndexType indexType) {
+    VkBuffer vertexBuffer;
+    VkBuffer indexBuffer;
+    {
+        // Loader threads may be adding pages
+        std::lock_guard<std::mutex> lock{ m_Mutex };
+        vertexBuffer = m_Pages[page]->vertexBuffer;
+        indexBuffer = m_Pages[page]->indexBuffer;
+    }
+
+    VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &offset);
+    vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, indexType);
+}
+
+uint32_t GeometryPool::GetPageCount() {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+    return static_cast<uint32_t>(m_Pages.size());
+}
+
+GeometryPool::Page& GeometryPool::CreatePage(uint32_t vertexCapacity, uint32_t indexCapacity) {
+    auto page = std::make_unique<Page>();
+
+    m_Device.CreateBuffer(
+        static_cast<VkDeviceSize>(m_VertexStride) * vertexCapacity,
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        page->vertexBuffer,
+        page->vertexMemory);
+
+    m_Device.CreateBuffer(
+        sizeof(uint32_t) * static_cast<VkDeviceSize>(indexCapacity),
+        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        page->indexBuffer,
+        page->indexMemory);
+
+    page->freeVertices.push_back({ 0, vertexCapacity });
+    page->freeIndices.push_back({ 0, 2 * indexCapacity });
+
+    m_Pages.push_back(std::move(page));
+    return *m_Pages.back();
+}
+
+uint32_t GeometryPool::GetIndexSize(VkIndexType indexType) {
+    return indexType == VK_INDEX_TYPE_UINT16 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+uint32_t GeometryPool::GetIndexUnits(uint32_t indexCount, VkIndexType indexType) {
+    // Rounded up to even so the next range starts 4 byte aligned
+    return indexType == VK_INDEX_TYPE_UINT16 ? (indexCount + 1) & ~1u : 2 * indexCount;
+}
+
+bool GeometryPool::TakeSpan(std::vector<Span>& freeSpans, uint32_t count, uint32_t& offset) {
+    auto it = std::find_if(freeSpans.begin(), freeSpans.end(), [count](const Span& span) { return span.count >= count; });
+    if (it == freeSpans.end()) {
+        return false;
+    }
+
+    offset = it->offset;
+    it->offset += count;
+    it->count -= count;
+
+    if (it->count == 0) {
+        freeSpans.erase(it);
+    }
+
+    return true;
+}
+
+void GeometryPool::ReturnSpan(std::vector<Span>& freeSpans, uint32_t offset, uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    auto next = std::lower_bound(
+        freeSpans.begin(),
+        freeSpans.end(),
+        offset,
+        [](const Span& span, uint32_t value) { return span.offset < value; });
+    next = freeSpans.insert(next, { offset, count });
+
+    if (next + 1 != freeSpans.end() && next->offset + next->count == (next + 1)->offset) {
+        next->count += (next + 1)->count;
+        freeSpans.erase(next + 1);
+    }
+
+    if (next != freeSpans.begin() && (next - 1)->offset + (next - 1)->count == next->offset) {
+        (next - 1)->count += next->count;
+        freeSpans.erase(next);
+    }
+}
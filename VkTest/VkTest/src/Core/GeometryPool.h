@@ -0,0 +1,82 @@
+#pragma once
+
+#include <Core/MemoryAllocator.h>
+#include <Core/UploadManager.h>
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class Device;
+
+// Where a mesh lives inside a GeometryPool, in the units vkCmdDrawIndexed expects
+struct GeometryRange {
+    int32_t     vertexOffset = 0;
+    uint32_t    vertexCount = 0;
+    uint32_t    firstIndex = 0;
+    uint32_t    indexCount = 0;
+    uint32_t    page = 0;           // which of the pool's buffer pairs holds it
+    VkIndexType indexType = VK_INDEX_TYPE_UINT32;   // firstIndex counts indices of this size
+};
+
+// Device-local vertex and index buffers shared by every mesh of a given vertex stride.
+// Storage comes in pages of one vertex and one index buffer each. A new page is only added
+// when no existing one has room, so nearly everything ends up in page 0 and a frame binds
+// geometry once per page. Ranges are handed out first-fit and coalesced again on Free.
+// 16 and 32 bit indices share a page's index buffer. Free index space is tracked in 16 bit
+// units and every range takes an even number of them, so 32 bit ranges stay aligned.
+class GeometryPool {
+public:
+    static constexpr uint32_t s_PageVertexCapacity = 1u << 20;
+    static constexpr uint32_t s_PageIndexCapacity = 4u << 20;     // in 32 bit indices
+public:
+    GeometryPool(Device& device, uint32_t vertexStride);
+    ~GeometryPool();
+
+    GeometryPool(const GeometryPool&) = delete;
+    GeometryPool& operator=(const GeometryPool&) = delete;
+
+    GeometryPool(GeometryPool&&) = delete;
+    GeometryPool& operator=(GeometryPool&&) = delete;
+public:
+    GeometryRange Allocate(uint32_t vertexCount, uint32_t indexCount, VkIndexType indexType = VK_INDEX_TYPE_UINT32);
+    void Free(const GeometryRange& range);
+    // indices holds range.indexCount indices of range.indexType
+    UploadManager::Ticket Upload(const GeometryRange& range, const void* vertices, const void* indices);
+
+    void Bind(VkCommandBuffer commandBuffer, uint32_t page, VkIndexType indexType);
+    uint32_t GetPageCount();
+    uint32_t GetVertexStride() const { return m_VertexStride; }
+private:
+    struct Span {
+        uint32_t offset;
+        uint32_t count;
+    };
+
+    struct Page {
+        VkBuffer            vertexBuffer;
+        MemoryAllocation    vertexMemory;
+        VkBuffer            indexBuffer;
+        MemoryAllocation    indexMemory;
+
+        std::vector<Span>   freeVertices;   // sorted by offset
+        std::vector<Span>   freeIndices;    // 16 bit units
+    };
+private:
+    Page& CreatePage(uint32_t vertexCapacity, uint32_t indexCapacity);
+
+    static uint32_t GetIndexSize(VkIndexType indexType);
+    static uint32_t GetIndexUnits(uint32_t indexCount, VkIndexType indexType);
+
+    static bool TakeSpan(std::vector<Span>& freeSpans, uint32_t count, uint32_t& offset);
+    static void ReturnSpan(std::vector<Span>& freeSpans, uint32_t offset, uint32_t count);
+private:
+    Device&             m_Device;
+    uint32_t            m_VertexStride;
+
+    std::vector<std::unique_ptr<Page>>  m_Pages;
+    std::mutex          m_Mutex;
+};
@@ -0,0 +1,286 @@
+#include "GpuProfiler.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+    // Nearest rank on an already sorted list
+    double Percentile(const std::vector<float>& sorted, double percentile) {
+        const size_t rank = static_cast<size_t>(percentile * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[std::min(rank, sorted.size() - 1)];
+    }
+}
+
+GpuProfiler::GpuProfiler(Device& device, bool collectStatistics, uint32_t historySize)
+    : m_Device{ device }, m_HistorySize{ std::max(historySize, 1u) } {
+    const uint32_t validBits = m_Device.GetTimestampValidBits();
+    if (validBits == 0) {
+        return;
+    }
+
+    m_TimestampPeriod = static_cast<double>(m_Device.properties.limits.timestampPeriod);
+    m_TimestampMask = validBits >= 64 ? UINT64_MAX : (1ull << validBits) - 1;
+
+    const auto& features = m_Device.GetEnabledFeatures();
+    collectStatistics = collectStatistics && features.pipelineStatisticsQuery && features.inheritedQueries;
+
+    for (uint32_t frame = 0; frame < SwapChain::MAX_FRAMES_IN_FLIGHT; frame++) {
+        VkQueryPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        poolInfo.queryCount = 2 * s_MaxScopes;
+
+        if (vkCreateQueryPool(m_Device.GetDevice(), &poolInfo, nullptr, &m_TimestampPool[frame]) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create timestamp query pool!");
+        }
+
+        if (collectStatistics) {
+            poolInfo.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+            poolInfo.queryCount = s_MaxScopes;
+            poolInfo.pipelineStatistics = s_StatisticFlags;
+
+            if (vkCreateQueryPool(m_Device.GetDevice(), &poolInfo, nullptr, &m_StatisticsPool[frame]) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create pipeline statistics query pool!");
+            }
+        }
+
+        m_FrameScopes[frame].reserve(s_MaxScopes);
+    }
+
+    // A value and an availability word per timestamp, or per statistics query
+    m_ResultScratch.resize(std::max(2 * s_MaxScopes * 2, s_MaxScopes * (s_StatisticCount + 1)));
+}
+
+GpuProfiler::~GpuProfiler() {
+    for (uint32_t frame = 0; frame < SwapChain::MAX_FRAMES_IN_FLIGHT; frame++) {
+        if (m_TimestampPool[frame] != VK_NULL_HANDLE) {
+            vkDestroyQueryPool(m_Device.GetDevice(), m_TimestampPool[frame], nullptr);
+        }
+        if (m_StatisticsPool[frame] != VK_NULL_HANDLE) {
+            vkDestroyQueryPool(m_Device.GetDevice(), m_StatisticsPool[frame], nullptr);
+        }
+    }
+}
+
+void GpuProfiler::BeginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex) {
+    if (!IsSupported()) {
+        return;
+    }
+
+    // The renderer waited on this frame's fence before handing out the command buffer
+    CollectFrame(frameIndex);
+
+    m_CurrentFrame = frameIndex;
+    m_ActiveStatisticsScope = s_InvalidScope;
+    m_FrameScopes[frameIndex].clear();
+
+    vkCmdResetQueryPool(commandBuffer, m_TimestampPool[frameIndex], 0, 2 * s_MaxScopes);
+    if (CollectsStatistics()) {
+        vkCmdResetQueryPool(commandBuffer, m_StatisticsPool[frameIndex], 0, s_MaxScopes);
+    }
+}
+
+uint32_t GpuProfiler::BeginScope(VkCommandBuffer commandBuffer, const char* name) {
+    if (!IsSupported() || m_CurrentFrame == UINT32_MAX) {
+        return s_InvalidScope;
+    }
+
+    auto& scopes = m_FrameScopes[m_CurrentFrame];
+    if (scopes.size() >= s_MaxScopes) {
+        return s_InvalidScope;
+    }
+
+    const uint32_t scope = static_cast<uint32_t>(scopes.size());
+    FrameScope frameScope{};
+    frameScope.nameIndex = GetNameIndex(name);
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_TimestampPool[m_CurrentFrame], 2 * scope);
+
+    // Only one statistics query may be active at a time
+    if (CollectsStatistics() && m_ActiveStatisticsScope == s_InvalidScope) {
+        vkCmdBeginQuery(commandBuffer, m_StatisticsPool[m_CurrentFrame], scope, 0);
+        m_ActiveStatisticsScope = scope;
+        frameScope.hasStatistics = true;
+    }
+
+    scopes.push_back(frameScope);
+    return scope;
+}
+
+void GpuProfiler::EndScope(VkCommandBuffer commandBuffer, uint32_t scope) {
+    if (scope == s_InvalidScope) {
+        return;
+    }
+
+    if (scope == m_ActiveStatisticsScope) {
+        vkCmdEndQuery(commandBuffer, m_StatisticsPool[m_CurrentFrame], scope);
+        m_ActiveStatisticsScope = s_InvalidScope;
+    }
+
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_TimestampPool[m_CurrentFrame], 2 * scope + 1);
+    m_FrameScopes[m_CurrentFrame][scope].ended = true;
+}
+
+void GpuProfiler::CollectAll() {
+    if (!IsSupported()) {
+        return;
+    }
+
+    // Oldest first, the frame after the current one is the next to come around
+    const uint32_t oldest = m_CurrentFrame == UINT32_MAX ? 0 : m_CurrentFrame + 1;
+    for (uint32_t i = 0; i < SwapChain::MAX_FRAMES_IN_FLIGHT; i++) {
+        const uint32_t frameIndex = (oldest + i) % SwapChain::MAX_FRAMES_IN_FLIGHT;
+        CollectFrame(frameIndex);
+        m_FrameScopes[frameIndex].clear();
+    }
+
+    m_CurrentFrame = UINT32_MAX;
+    m_ActiveStatisticsScope = s_InvalidScope;
+}
+
+std::vector<GpuProfiler::ScopeStats> GpuProfiler::GetStats() const {
+    std::vector<ScopeStats> result{};
+    result.reserve(m_Histories.size());
+
+    std::vector<float> sorted{};
+    for (const auto& history : m_Histories) {
+        ScopeStats stats{};
+        stats.name = history.name;
+        stats.sampleCount = history.count;
+        if (history.count == 0) {
+            result.push_back(stats);
+            continue;
+        }
+
+        sorted.clear();
+        double total = 0.0;
+        uint32_t statisticsCount = 0;
+        std::array<double, s_StatisticCount> statisticsTotal{};
+        for (uint32_t i = 0; i < history.count; i++) {
+            const Sample& sample = history.samples[i];
+            sorted.push_back(sample.milliseconds);
+            total += sample.milliseconds;
+
+            if (sample.hasStatistics) {
+                statisticsCount++;
+                for (uint32_t statistic = 0; statistic < s_StatisticCount; statistic++) {
+                    statisticsTotal[statistic] += static_cast<double>(sample.statistics[statistic]);
+                }
+            }
+        }
+        std::sort(sorted.begin(), sorted.end());
+
+        stats.averageMs = total / static_cast<double>(history.count);
+        stats.p50Ms = Percentile(sorted, 0.50);
+        stats.p95Ms = Percentile(sorted, 0.95);
+        stats.p99Ms = Percentile(sorted, 0.99);
+        stats.maxMs = sorted.back();
+
+        if (statisticsCount > 0) {
+            // Same order as the bits in s_StatisticFlags
+            stats.hasStatistics = true;
+            stats.primitives = statisticsTotal[0] / statisticsCount;
+            stats.vertexInvocations = statisticsTotal[1] / statisticsCount;
+            stats.clippingPrimitives = statisticsTotal[2] / statisticsCount;
+            stats.fragmentInvocations = statisticsTotal[3] / statisticsCount;
+        }
+
+        result.push_back(stats);
+    }
+
+    return result;
+}
+
+void GpuProfiler::ResetHistory() {
+    for (auto& history : m_Histories) {
+        history.next = 0;
+        history.count = 0;
+    }
+}
+
+void GpuProfiler::CollectFrame(uint32_t frameIndex) {
+    const auto& scopes = m_FrameScopes[frameIndex];
+    if (scopes.empty()) {
+        return;
+    }
+
+    const uint32_t scopeCount = static_cast<uint32_t>(scopes.size());
+    constexpr VkQueryResultFlags flags = VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
+
+    // Without the wait bit this returns VK_NOT_READY instead of blocking, the availability
+    // words say which queries made it, so a scope that was never ended is simply skipped
+    std::vector<uint64_t>& timestamps = m_ResultScratch;
+    vkGetQueryPoolResults(
+        m_Device.GetDevice(),
+        m_TimestampPool[frameIndex],
+        0,
+        2 * scopeCount,
+        2 * scopeCount * 2 * sizeof(uint64_t),
+        timestamps.data(),
+        2 * sizeof(uint64_t),
+        flags);
+
+    std::vector<Sample> samples(scopeCount);
+    std::vector<bool> valid(scopeCount, false);
+    for (uint32_t scope = 0; scope < scopeCount; scope++) {
+        const uint64_t* begin = &timestamps[4 * scope];
+        const uint64_t* end = &timestamps[4 * scope + 2];
+        if (!scopes[scope].ended || begin[1] == 0 || end[1] == 0) {
+            continue;
+        }
+
+        const uint64_t ticks = (end[0] - begin[0]) & m_TimestampMask;
+        samples[scope].milliseconds = static_cast<float>(static_cast<double>(ticks) * m_TimestampPeriod * 1e-6);
+        valid[scope] = true;
+    }
+
+    if (CollectsStatistics()) {
+        std::vector<uint64_t>& statistics = m_ResultScratch;
+        constexpr uint32_t stride = s_StatisticCount + 1;
+        vkGetQueryPoolResults(
+            m_Device.GetDevice(),
+            m_StatisticsPool[frameIndex],
+            0,
+            scopeCount,
+            scopeCount * stride * sizeof(uint64_t),
+            statistics.data(),
+            stride * sizeof(uint64_t),
+            flags);
+
+        for (uint32_t scope = 0; scope < scopeCount; scope++) {
+            const uint64_t* result = &statistics[stride * scope];
+            if (!scopes[scope].hasStatistics || result[s_StatisticCount] == 0) {
+                continue;
+            }
+
+            samples[scope].hasStatistics = true;
+            std::copy(result, result + s_StatisticCount, samples[scope].statistics.begin());
+        }
+    }
+
+    for (uint32_t scope = 0; scope < scopeCount; scope++) {
+        if (!valid[scope]) {
+            continue;
+        }
+
+        History& history = m_Histories[scopes[scope].nameIndex];
+        history.samples[history.next] = samples[scope];
+        history.next = (history.next + 1) % m_HistorySize;
+        history.count = std::min(history.count + 1, m_HistorySize);
+    }
+}
+
+uint32_t GpuProfiler::GetNameIndex(const char* name) {
+    auto it = m_NameIndices.find(name);
+    if (it != m_NameIndices.end()) {
+        return it->second;
+    }
+
+    const uint32_t index = static_cast<uint32_t>(m_Histories.size());
+    History history{};
+    history.name = name;
+    history.samples.resize(m_HistorySize);
+    m_Histories.push_back(std::move(history));
+    m_NameIndices.emplace(name, index);
+    return index;
+}
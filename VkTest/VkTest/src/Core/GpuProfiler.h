@@ -0,0 +1,127 @@
+#pragma once
+
+#include <Core/Device.h>
+#include <Core/SwapChain.h>
+
+#include <vulkan/vulkan.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Times named regions of a frame on the GPU with timestamp queries, optionally counting
+// shader invocations with pipeline statistics queries. Every frame in flight has its own
+// query pools, read back when the frame index comes around again and its fence has been
+// waited on, so reading never stalls. Results are MAX_FRAMES_IN_FLIGHT frames late.
+//
+// Scopes may nest. They cannot be opened inside a render pass begun with secondary contents,
+// and only the outermost scope collects statistics.
+class GpuProfiler {
+public:
+    static constexpr uint32_t s_MaxScopes = 32;         // per frame, further scopes are not timed
+    static constexpr uint32_t s_HistorySize = 240;      // default frames kept per scope for averages and percentiles
+    static constexpr uint32_t s_InvalidScope = UINT32_MAX;
+    static constexpr uint32_t s_StatisticCount = 4;
+    static constexpr VkQueryPipelineStatisticFlags s_StatisticFlags =
+        VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+        VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT;
+
+    // Averages and percentiles over the last historySize frames the scope was recorded in
+    struct ScopeStats {
+        std::string name;
+        uint32_t    sampleCount = 0;
+        double      averageMs = 0.0;
+        double      p50Ms = 0.0;
+        double      p95Ms = 0.0;
+        double      p99Ms = 0.0;
+        double      maxMs = 0.0;
+        bool        hasStatistics = false;  // the rest is only set for scopes that collected statistics
+        double      primitives = 0.0;       // averages per frame
+        double      vertexInvocations = 0.0;
+        double      clippingPrimitives = 0.0;
+        double      fragmentInvocations = 0.0;
+    };
+
+    // Ends the scope when it goes out of scope
+    class Scope {
+    public:
+        Scope(GpuProfiler& profiler, VkCommandBuffer commandBuffer, const char* name)
+            : m_Profiler{ profiler }, m_CommandBuffer{ commandBuffer }, m_Id{ profiler.BeginScope(commandBuffer, name) } {}
+        ~Scope() { m_Profiler.EndScope(m_CommandBuffer, m_Id); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        GpuProfiler&    m_Profiler;
+        VkCommandBuffer m_CommandBuffer;
+        uint32_t        m_Id;
+    };
+public:
+    // Statistics are only collected when asked for and the device enabled pipelineStatisticsQuery
+    // and inheritedQueries, the latter so scopes may contain secondary command buffers
+    GpuProfiler(Device& device, bool collectStatistics = false, uint32_t historySize = s_HistorySize);
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    GpuProfiler(GpuProfiler&&) = delete;
+    GpuProfiler& operator=(GpuProfiler&&) = delete;
+public:
+    // Call outside a render pass right after Renderer::BeginFrame. Collects what the previous
+    // use of frameIndex recorded and resets its queries.
+    void BeginFrame(VkCommandBuffer commandBuffer, uint32_t frameIndex);
+    // Returns an id for EndScope, s_InvalidScope when out of queries or unsupported
+    uint32_t BeginScope(VkCommandBuffer commandBuffer, const char* name);
+    void EndScope(VkCommandBuffer commandBuffer, uint32_t scope);
+    // Collects every frame that has not come around again yet. Only after vkDeviceWaitIdle,
+    // for the last frames of a run; the next BeginFrame starts over.
+    void CollectAll();
+
+    bool IsSupported() const { return m_TimestampPool[0] != VK_NULL_HANDLE; }
+    bool CollectsStatistics() const { return m_StatisticsPool[0] != VK_NULL_HANDLE; }
+    // One entry per scope name seen so far, in first seen order
+    std::vector<ScopeStats> GetStats() const;
+    void ResetHistory();
+private:
+    struct FrameScope {
+        uint32_t    nameIndex = 0;
+        bool        ended = false;
+        bool        hasStatistics = false;
+    };
+
+    struct Sample {
+        float       milliseconds = 0.0f;
+        bool        hasStatistics = false;
+        std::array<uint64_t, s_StatisticCount> statistics{};
+    };
+
+    struct History {
+        std::string         name;
+        std::vector<Sample> samples;    // ring of m_HistorySize
+        uint32_t            next = 0;
+        uint32_t            count = 0;
+    };
+private:
+    void CollectFrame(uint32_t frameIndex);
+    uint32_t GetNameIndex(const char* name);
+private:
+    Device&						m_Device;
+    double						m_TimestampPeriod = 1.0;    // nanoseconds per tick
+    uint64_t					m_TimestampMask = 0;
+    uint32_t					m_HistorySize;
+    uint32_t					m_CurrentFrame = UINT32_MAX;
+    uint32_t					m_ActiveStatisticsScope = s_InvalidScope;
+
+    std::array<VkQueryPool, SwapChain::MAX_FRAMES_IN_FLIGHT>			m_TimestampPool{};
+    std::array<VkQueryPool, SwapChain::MAX_FRAMES_IN_FLIGHT>			m_StatisticsPool{};
+    std::array<std::vector<FrameScope>, SwapChain::MAX_FRAMES_IN_FLIGHT>	m_FrameScopes;
+
+    std::vector<History>						m_Histories;
+    std::unordered_map<std::string, uint32_t>	m_NameIndices;
+    std::vector<uint64_t>						m_ResultScratch;
+};
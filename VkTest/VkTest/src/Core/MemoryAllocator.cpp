@@ -0,0 +1,301 @@
+#include "MemoryAllocator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+float MemoryStats::ExternalFragmentation() const {
+    if (freeBytes == 0) {
+        return 0.0f;
+    }
+    return 1.0f - static_cast<float>(largestFreeRange) / static_cast<float>(freeBytes);
+}
+
+float MemoryStats::InternalFragmentation() const {
+    if (allocatedBytes == 0) {
+        return 0.0f;
+    }
+    return 1.0f - static_cast<float>(requestedBytes) / static_cast<float>(allocatedBytes);
+}
+
+MemoryAllocator::MemoryAllocator(VkDevice device, VkPhysicalDevice physicalDevice)
+    : m_Device{ device } {
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &m_MemoryProperties);
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    m_MaxAllocationCount = properties.limits.maxMemoryAllocationCount;
+
+    m_Pools.resize(m_MemoryProperties.memoryTypeCount * 2);
+    for (uint32_t i = 0; i < m_Pools.size(); i++) {
+        m_Pools[i].memoryType = i / 2;
+        m_Pools[i].linear = (i % 2) == 0;
+    }
+}
+
+MemoryAllocator::~MemoryAllocator() {
+    for (auto& pool : m_Pools) {
+        for (auto& block : pool.blocks) {
+            if (block) {
+                DestroyBlock(*block);
+            }
+        }
+    }
+
+    for (auto& block : m_DedicatedBlocks) {
+        if (block) {
+            DestroyBlock(*block);
+        }
+    }
+}
+
+MemoryAllocation MemoryAllocator::Allocate(
+        const VkMemoryRequirements& requirements,
+        VkMemoryPropertyFlags properties,
+        bool linear) {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    const uint32_t memoryType = FindMemoryType(requirements.memoryTypeBits, properties);
+    const VkDeviceSize alignedSize = std::max({ requirements.size, requirements.alignment, s_MinAllocationSize });
+    const uint32_t order = OrderForSize(alignedSize);
+
+    MemoryAllocation allocation{};
+    allocation.size = requirements.size;
+    allocation.order = order;
+
+    if (SizeForOrder(order) > s_BlockSize / 2) {
+        auto block = CreateBlock(memoryType, requirements.size, 0);
+        block->usedBytes = block->size;
+        block->requestedBytes = requirements.size;
+        block->allocationCount = 1;
+
+        auto slot = std::find(m_DedicatedBlocks.begin(), m_DedicatedBlocks.end(), nullptr);
+        if (slot == m_DedicatedBlocks.end()) {
+            slot = m_DedicatedBlocks.insert(m_DedicatedBlocks.end(), nullptr);
+        }
+
+        allocation.memory = block->memory;
+        allocation.mappedData = block->mappedData;
+        allocation.blockIndex = static_cast<uint32_t>(slot - m_DedicatedBlocks.begin());
+        *slot = std::move(block);
+
+        return allocation;
+    }
+
+    const uint32_t poolIndex = memoryType * 2 + (linear ? 0 : 1);
+    auto& pool = m_Pools[poolIndex];
+    const uint32_t orderCount = OrderForSize(s_BlockSize) + 1;
+
+    VkDeviceSize offset = 0;
+    uint32_t blockIndex = UINT32_MAX;
+    for (uint32_t i = 0; i < pool.blocks.size(); i++) {
+        if (pool.blocks[i] && AllocateFromBlock(*pool.blocks[i], order, offset)) {
+            blockIndex = i;
+            break;
+        }
+    }
+
+    if (blockIndex == UINT32_MAX) {
+        auto slot = std::find(pool.blocks.begin(), pool.blocks.end(), nullptr);
+        if (slot == pool.blocks.end()) {
+            slot = pool.blocks.insert(pool.blocks.end(), nullptr);
+        }
+
+        *slot = CreateBlock(memoryType, s_BlockSize, orderCount);
+        blockIndex = static_cast<uint32_t>(slot - pool.blocks.begin());
+
+        if (!AllocateFromBlock(**slot, order, offset)) {
+            throw std::runtime_error("failed to sub-allocate from a fresh memory block!");
+        }
+    }
+
+    auto& block = *pool.blocks[blockIndex];
+    block.usedBytes += SizeForOrder(order);
+    block.requestedBytes += requirements.size;
+    block.allocationCount++;
+
+    allocation.memory = block.memory;
+    allocation.offset = offset;
+    allocation.mappedData = block.mappedData ? static_cast<char*>(block.mappedData) + offset : nullptr;
+    allocation.poolIndex = poolIndex;
+    allocation.blockIndex = blockIndex;
+
+    return allocation;
+}
+
+void MemoryAllocator::Free(MemoryAllocation& allocation) {
+    if (allocation.memory == VK_NULL_HANDLE) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    if (allocation.poolIndex == UINT32_MAX) {
+        auto& block = m_DedicatedBlocks[allocation.blockIndex];
+        DestroyBlock(*block);
+        block.reset();
+    }
+    else {
+        auto& pool = m_Pools[allocation.poolIndex];
+        auto& block = *pool.blocks[allocation.blockIndex];
+
+        FreeToBlock(block, allocation.offset, allocation.order);
+        block.usedBytes -= SizeForOrder(allocation.order);
+        block.requestedBytes -= allocation.size;
+        block.allocationCount--;
+
+        // Keep one empty page around so alternating create/destroy does not thrash the driver
+        if (block.allocationCount == 0) {
+            auto liveBlocks = std::count_if(
+                pool.blocks.begin(),
+                pool.blocks.end(),
+                [](const std::unique_ptr<Block>& b) { return b != nullptr; });
+            if (liveBlocks > 1) {
+                DestroyBlock(block);
+                pool.blocks[allocation.blockIndex].reset();
+            }
+        }
+    }
+
+    allocation = MemoryAllocation{};
+}
+
+MemoryStats MemoryAllocator::GetStats() const {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    MemoryStats stats{};
+    stats.deviceAllocationCount = m_DeviceAllocationCount;
+
+    for (const auto& pool : m_Pools) {
+        for (const auto& block : pool.blocks) {
+            if (!block) {
+                continue;
+            }
+
+            stats.allocationCount += block->allocationCount;
+            stats.reservedBytes += block->size;
+            stats.requestedBytes += block->requestedBytes;
+            stats.allocatedBytes += block->usedBytes;
+            stats.freeBytes += block->size - block->usedBytes;
+
+            for (uint32_t order = static_cast<uint32_t>(block->freeLists.size()); order-- > 0;) {
+                if (!block->freeLists[order].empty()) {
+                    stats.largestFreeRange = std::max(stats.largestFreeRange, SizeForOrder(order));
+                    break;
+                }
+            }
+        }
+    }
+
+    for (const auto& block : m_DedicatedBlocks) {
+        if (block) {
+            stats.allocationCount++;
+            stats.reservedBytes += block->size;
+            stats.requestedBytes += block->requestedBytes;
+            stats.allocatedBytes += block->usedBytes;
+        }
+    }
+
+    return stats;
+}
+
+uint32_t MemoryAllocator::FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const {
+    for (uint32_t i = 0; i < m_MemoryProperties.memoryTypeCount; i++) {
+        if ((typeFilter & (1 << i)) &&
+            (m_MemoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+
+    throw std::runtime_error("failed to find suitable memory type!");
+}
+
+std::unique_ptr<MemoryAllocator::Block> MemoryAllocator::CreateBlock(
+        uint32_t memoryType,
+        VkDeviceSize size,
+        uint32_t orderCount) {
+    if (m_DeviceAllocationCount >= m_MaxAllocationCount) {
+        throw std::runtime_error("maxMemoryAllocationCount exceeded!");
+    }
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = size;
+    allocInfo.memoryTypeIndex = memoryType;
+
+    auto block = std::make_unique<Block>();
+    block->size = size;
+    if (vkAllocateMemory(m_Device, &allocInfo, nullptr, &block->memory) != VK_SUCCESS) {
+        throw std::runtime_error("failed to allocate device memory block!");
+    }
+    m_DeviceAllocationCount++;
+
+    if (m_MemoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+        if (vkMapMemory(m_Device, block->memory, 0, VK_WHOLE_SIZE, 0, &block->mappedData) != VK_SUCCESS) {
+            throw std::runtime_error("failed to map device memory block!");
+        }
+    }
+
+    block->freeLists.resize(orderCount);
+    if (orderCount > 0) {
+        block->freeLists[orderCount - 1].insert(0);
+    }
+
+    return block;
+}
+
+void MemoryAllocator::DestroyBlock(Block& block) {
+    if (block.mappedData) {
+        vkUnmapMemory(m_Device, block.memory);
+    }
+    vkFreeMemory(m_Device, block.memory, nullptr);
+    m_DeviceAllocationCount--;
+}
+
+bool MemoryAllocator::AllocateFromBlock(Block& block, uint32_t order, VkDeviceSize& offset) {
+    uint32_t k = order;
+    while (k < block.freeLists.size() && block.freeLists[k].empty()) {
+        k++;
+    }
+
+    if (k >= block.freeLists.size()) {
+        return false;
+    }
+
+    // Lowest offset first keeps live allocations packed at the start of the page
+    auto first = block.freeLists[k].begin();
+    offset = *first;
+    block.freeLists[k].erase(first);
+
+    while (k > order) {
+        k--;
+        block.freeLists[k].insert(offset + SizeForOrder(k));
+    }
+
+    return true;
+}
+
+void MemoryAllocator::FreeToBlock(Block& block, VkDeviceSize offset, uint32_t order) {
+    const uint32_t maxOrder = static_cast<uint32_t>(block.freeLists.size()) - 1;
+
+    while (order < maxOrder) {
+        const VkDeviceSize buddy = offset ^ SizeForOrder(order);
+        auto it = block.freeLists[order].find(buddy);
+        if (it == block.freeLists[order].end()) {
+            break;
+        }
+
+        block.freeLists[order].erase(it);
+        offset = std::min(offset, buddy);
+        order++;
+    }
+
+    block.freeLists[order].insert(offset);
+}
+
+uint32_t MemoryAllocator::OrderForSize(VkDeviceSize size) {
+    uint32_t order = 0;
+    while (SizeForOrder(order) < size) {
+        order++;
+    }
+    return order;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+// Handle to a range of device memory. Host-visible allocations are persistently mapped,
+// mappedData already points at offset.
+struct MemoryAllocation {
+    VkDeviceMemory  memory = VK_NULL_HANDLE;
+    VkDeviceSize    offset = 0;
+    VkDeviceSize    size = 0;
+    void*           mappedData = nullptr;
+
+    uint32_t        poolIndex = UINT32_MAX;
+    uint32_t        blockIndex = UINT32_MAX;
+    uint32_t        order = 0;
+};
+
+struct MemoryStats {
+    uint32_t        deviceAllocationCount = 0;
+    uint32_t        allocationCount = 0;
+    VkDeviceSize    reservedBytes = 0;      // sum of all vkAllocateMemory sizes
+    VkDeviceSize    requestedBytes = 0;     // what callers asked for
+    VkDeviceSize    allocatedBytes = 0;     // requested size rounded up to buddy size
+    VkDeviceSize    freeBytes = 0;
+    VkDeviceSize    largestFreeRange = 0;
+
+    // 0 when all free memory is one contiguous range, approaching 1 when it is scattered
+    float ExternalFragmentation() const;
+    // Share of handed out memory lost to power-of-two rounding
+    float InternalFragmentation() const;
+};
+
+// Buddy sub-allocator. One pool per memory type and resource kind (linear buffers and
+// optimal images are kept apart to satisfy bufferImageGranularity), each pool grows in
+// s_BlockSize pages. Requests larger than half a page get a dedicated allocation.
+class MemoryAllocator {
+public:
+    static constexpr VkDeviceSize s_BlockSize = 64ull * 1024 * 1024;
+    static constexpr VkDeviceSize s_MinAllocationSize = 256;
+public:
+    MemoryAllocator(VkDevice device, VkPhysicalDevice physicalDevice);
+    ~MemoryAllocator();
+
+    MemoryAllocator(const MemoryAllocator&) = delete;
+    MemoryAllocator& operator=(const MemoryAllocator&) = delete;
+
+    MemoryAllocator(MemoryAllocator&&) = delete;
+    MemoryAllocator& operator=(MemoryAllocator&&) = delete;
+public:
+    MemoryAllocation Allocate(
+        const VkMemoryRequirements& requirements,
+        VkMemoryPropertyFlags properties,
+        bool linear);
+    void Free(MemoryAllocation& allocation);
+
+    MemoryStats GetStats() const;
+    uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties) const;
+private:
+    struct Block {
+        VkDeviceMemory                      memory = VK_NULL_HANDLE;
+        void*                               mappedData = nullptr;
+        VkDeviceSize                        size = 0;
+        VkDeviceSize                        usedBytes = 0;
+        VkDeviceSize                        requestedBytes = 0;
+        uint32_t                            allocationCount = 0;
+        std::vector<std::set<VkDeviceSize>> freeLists;  // free offsets per order
+    };
+
+    struct Pool {
+        uint32_t                            memoryType = 0;
+        bool                                linear = true;
+        std::vector<std::unique_ptr<Block>> blocks;
+    };
+private:
+    std::unique_ptr<Block> CreateBlock(uint32_t memoryType, VkDeviceSize size, uint32_t orderCount);
+    void DestroyBlock(Block& block);
+    bool AllocateFromBlock(Block& block, uint32_t order, VkDeviceSize& offset);
+    void FreeToBlock(Block& block, VkDeviceSize offset, uint32_t order);
+
+    static uint32_t OrderForSize(VkDeviceSize size);
+    static VkDeviceSize SizeForOrder(uint32_t order) { return s_MinAllocationSize << order; }
+private:
+    VkDevice                            m_Device;
+    VkPhysicalDeviceMemoryProperties    m_MemoryProperties;
+    uint32_t                            m_MaxAllocationCount;
+
+    std::vector<Pool>                   m_Pools;
+    std::vector<std::unique_ptr<Block>> m_DedicatedBlocks;
+    uint32_t                            m_DeviceAllocationCount = 0;
+    mutable std::mutex                  m_Mutex;
+};
@@ -0,0 +1,220 @@
+#include "MeshCache.h"
+#include <Core/Utils.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    // Read-only memory mapping of a whole file, unmapped on destruction. An empty file opens
+    // without a mapping, Data() is null then.
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& filepath) {
+#ifdef _WIN32
+            m_File = CreateFileA(
+                filepath.c_str(),
+                GENERIC_READ,
+                FILE_SHARE_READ,
+                nullptr,
+                OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                nullptr);
+            if (m_File == INVALID_HANDLE_VALUE) {
+                return;
+            }
+
+            LARGE_INTEGER size{};
+            if (!GetFileSizeEx(m_File, &size)) {
+                return;
+            }
+            if (size.QuadPart == 0) {
+                m_Open = true;
+                return;
+            }
+
+            m_Mapping = CreateFileMappingA(m_File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m_Mapping == nullptr) {
+                return;
+            }
+
+            m_pData = static_cast<const uint8_t*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+            m_Size = m_pData ? static_cast<size_t>(size.QuadPart) : 0;
+            m_Open = m_pData != nullptr;
+#else
+            m_File = open(filepath.c_str(), O_RDONLY);
+            if (m_File < 0) {
+                return;
+            }
+
+            struct stat st {};
+            if (fstat(m_File, &st) != 0) {
+                return;
+            }
+            if (st.st_size == 0) {
+                m_Open = true;
+                return;
+            }
+
+            void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, m_File, 0);
+            if (data == MAP_FAILED) {
+                return;
+            }
+
+            m_pData = static_cast<const uint8_t*>(data);
+            m_Size = static_cast<size_t>(st.st_size);
+            m_Open = true;
+#endif
+        }
+
+        ~MappedFile() {
+#ifdef _WIN32
+            if (m_pData) UnmapViewOfFile(m_pData);
+            if (m_Mapping) CloseHandle(m_Mapping);
+            if (m_File != INVALID_HANDLE_VALUE) CloseHandle(m_File);
+#else
+            if (m_pData) munmap(const_cast<uint8_t*>(m_pData), m_Size);
+            if (m_File >= 0) close(m_File);
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool IsOpen() const { return m_Open; }
+        const uint8_t* Data() const { return m_pData; }
+        size_t Size() const { return m_Size; }
+    private:
+#ifdef _WIN32
+        HANDLE          m_File = INVALID_HANDLE_VALUE;
+        HANDLE          m_Mapping = nullptr;
+#else
+        int             m_File = -1;
+#endif
+        const uint8_t*  m_pData = nullptr;
+        size_t          m_Size = 0;
+        bool            m_Open = false;
+    };
+}
+
+std::string MeshCache::GetCachePath(const std::string& sourcePath) {
+    return std::filesystem::path(sourcePath).replace_extension(".mesh").string();
+}
+
+uint64_t MeshCache::HashFile(const std::string& filepath) {
+    MappedFile file{ filepath };
+    if (!file.IsOpen()) {
+        throw std::runtime_error("Failed to open file:" + filepath);
+    }
+
+    return hashBytes(file.Data(), file.Size());
+}
+
+uint32_t MeshCache::GetFlags(const Model::Builder& builder) {
+    return (builder.optimize ? FlagOptimized : 0) | (builder.splitLargeMeshes ? FlagSplitLargeMeshes : 0);
+}
+
+uint64_t MeshCache::HashLodRatios(const Model::Builder& builder) {
+    return hashBytes(builder.lodRatios.data(), builder.lodRatios.size() * sizeof(float));
+}
+
+bool MeshCache::Load(const std::string& cachePath, uint64_t sourceHash, Model::Builder& builder) {
+    MappedFile file{ cachePath };
+    if (!file.IsOpen() || file.Size() < sizeof(Header)) {
+        return false;
+    }
+
+    Header header{};
+    memcpy(&header, file.Data(), sizeof(Header));
+
+    if (header.magic != s_Magic ||
+        header.version != s_Version ||
+        header.vertexStride != sizeof(Model::Vertex) ||
+        header.indexStride != sizeof(uint32_t) ||
+        header.flags != GetFlags(builder) ||
+        header.sourceHash != sourceHash ||
+        header.lodRatioHash != HashLodRatios(builder) ||
+        header.lodCount > builder.lodRatios.size()) {
+        return false;
+    }
+
+    const size_t vertexBytes = static_cast<size_t>(header.vertexCount) * sizeof(Model::Vertex);
+    const size_t indexBytes = static_cast<size_t>(header.indexCount) * sizeof(uint32_t);
+    const size_t lodCountBytes = static_cast<size_t>(header.lodCount) * sizeof(uint64_t);
+    if (file.Size() < sizeof(Header) + vertexBytes + indexBytes + lodCountBytes) {
+        return false;
+    }
+
+    const uint8_t* vertexData = file.Data() + sizeof(Header);
+    const uint8_t* indexData = vertexData + vertexBytes;
+    const uint8_t* lodCountData = indexData + indexBytes;
+    const uint8_t* lodIndexData = lodCountData + lodCountBytes;
+
+    std::vector<uint64_t> lodIndexCounts(header.lodCount);
+    memcpy(lodIndexCounts.data(), lodCountData, lodCountBytes);
+    size_t lodIndexBytes = 0;
+    for (uint64_t count : lodIndexCounts) {
+        if (count > header.indexCount) {
+            return false;
+        }
+        lodIndexBytes += static_cast<size_t>(count) * sizeof(uint32_t);
+    }
+    if (file.Size() != sizeof(Header) + vertexBytes + indexBytes + lodCountBytes + lodIndexBytes) {
+        return false;
+    }
+
+    builder.vertices.resize(static_cast<size_t>(header.vertexCount));
+    builder.indices.resize(static_cast<size_t>(header.indexCount));
+    memcpy(builder.vertices.data(), vertexData, vertexBytes);
+    memcpy(builder.indices.data(), indexData, indexBytes);
+
+    builder.lodIndices.resize(lodIndexCounts.size());
+    for (size_t lod = 0; lod < lodIndexCounts.size(); lod++) {
+        const size_t bytes = static_cast<size_t>(lodIndexCounts[lod]) * sizeof(uint32_t);
+        builder.lodIndices[lod].resize(static_cast<size_t>(lodIndexCounts[lod]));
+        memcpy(builder.lodIndices[lod].data(), lodIndexData, bytes);
+        lodIndexData += bytes;
+    }
+
+    return true;
+}
+
+bool MeshCache::Save(const std::string& cachePath, uint64_t sourceHash, const Model::Builder& builder) {
+    Header header{};
+    header.magic = s_Magic;
+    header.version = s_Version;
+    header.vertexStride = sizeof(Model::Vertex);
+    header.indexStride = sizeof(uint32_t);
+    header.flags = GetFlags(builder);
+    header.lodCount = static_cast<uint32_t>(builder.lodIndices.size());
+    header.sourceHash = sourceHash;
+    header.lodRatioHash = HashLodRatios(builder);
+    header.vertexCount = builder.vertices.size();
+    header.indexCount = builder.indices.size();
+
+    std::vector<uint64_t> lodIndexCounts{};
+    std::vector<uint32_t> lodIndices{};
+    for (const auto& level : builder.lodIndices) {
+        lodIndexCounts.push_back(level.size());
+        lodIndices.insert(lodIndices.end(), level.begin(), level.end());
+    }
+
+    return writeFileAtomic(cachePath, {
+        { &header, sizeof(Header) },
+        { builder.vertices.data(), builder.vertices.size() * sizeof(Model::Vertex) },
+        { builder.indices.data(), builder.indices.size() * sizeof(uint32_t) },
+        { lodIndexCounts.data(), lodIndexCounts.size() * sizeof(uint64_t) },
+        { lodIndices.data(), lodIndices.size() * sizeof(uint32_t) } });
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Core/Model.h>
+
+#include <cstdint>
+#include <string>
+
+// Binary dump of a deduplicated Model::Builder, stored next to the source .obj.
+// Layout: Header | Vertex[vertexCount] | uint32_t[indexCount] | uint64_t[lodCount] index counts
+// of the simplified levels | their uint32_t indices back to back
+class MeshCache {
+public:
+    static constexpr uint32_t s_Magic = 0x48534D56; // "VMSH"
+    static constexpr uint32_t s_Version = 3;
+
+    enum Flags : uint32_t {
+        FlagOptimized        = 1u << 0,  // went through Model::Builder::Optimize
+        FlagSplitLargeMeshes = 1u << 1   // split meshes carry no levels of detail
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t vertexStride;
+        uint32_t indexStride;
+        uint32_t flags;
+        uint32_t lodCount;
+        uint64_t sourceHash;
+        uint64_t lodRatioHash;  // of Model::Builder::lodRatios
+        uint64_t vertexCount;
+        uint64_t indexCount;
+    };
+public:
+    static std::string GetCachePath(const std::string& sourcePath);
+    static uint64_t HashFile(const std::string& filepath);
+
+    // Only succeeds if the cached mesh was built with the builder's optimize, splitLargeMeshes
+    // and lodRatios
+    static bool Load(const std::string& cachePath, uint64_t sourceHash, Model::Builder& builder);
+    static bool Save(const std::string& cachePath, uint64_t sourceHash, const Model::Builder& builder);
+private:
+    static uint32_t GetFlags(const Model::Builder& builder);
+    static uint64_t HashLodRatios(const Model::Builder& builder);
+};
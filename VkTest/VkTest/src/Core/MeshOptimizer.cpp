@@ -0,0 +1,294 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+    // A vertex counts as cached while fewer than size misses happened since it was added
+    class FifoCache {
+    public:
+        FifoCache(size_t vertexCount, uint32_t size)
+            : m_Time(vertexCount, 0), m_Now{ size + 1 }, m_Size{ size } {}
+
+        bool Contains(uint32_t vertex) const { return m_Now - m_Time[vertex] <= m_Size; }
+        // Age in misses, only meaningful while cached
+        uint32_t Age(uint32_t vertex) const { return m_Now - m_Time[vertex]; }
+
+        // Returns true on a miss
+        bool Touch(uint32_t vertex) {
+            if (Contains(vertex)) {
+                return false;
+            }
+            m_Time[vertex] = m_Now++;
+            return true;
+        }
+
+        void Clear() { m_Now += m_Size; }
+    private:
+        std::vector<uint32_t> m_Time;
+        uint32_t m_Now;
+        uint32_t m_Size;
+    };
+
+    // Triangles using each vertex, with a triangle listed once per corner
+    struct Adjacency {
+        std::vector<uint32_t> offsets;
+        std::vector<uint32_t> triangles;
+
+        Adjacency(const std::vector<uint32_t>& indices, size_t vertexCount) : offsets(vertexCount + 1, 0) {
+            for (uint32_t index : indices) {
+                offsets[index + 1]++;
+            }
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+            triangles.resize(indices.size());
+            for (size_t corner = 0; corner < indices.size(); corner++) {
+                triangles[cursors[indices[corner]]++] = static_cast<uint32_t>(corner / 3);
+            }
+        }
+    };
+}
+
+MeshOptimizer::CacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize) {
+    CacheStats stats{};
+    if (indices.size() < 3) {
+        return stats;
+    }
+
+    FifoCache cache{ vertexCount, cacheSize };
+    std::vector<bool> referenced(vertexCount, false);
+    size_t misses = 0;
+    size_t referencedCount = 0;
+
+    for (uint32_t index : indices) {
+        misses += cache.Touch(index) ? 1 : 0;
+        if (!referenced[index]) {
+            referenced[index] = true;
+            referencedCount++;
+        }
+    }
+
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+    stats.atvr = static_cast<float>(misses) / static_cast<float>(referencedCount);
+    return stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    const Adjacency adjacency{ indices, vertexCount };
+
+    // Triangles not yet emitted per vertex
+    std::vector<uint32_t> liveTriangles(vertexCount);
+    for (size_t vertex = 0; vertex < vertexCount; vertex++) {
+        liveTriangles[vertex] = adjacency.offsets[vertex + 1] - adjacency.offsets[vertex];
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnds{};
+    std::vector<uint32_t> candidates{};
+    std::vector<uint32_t> result{};
+    result.reserve(triangleCount * 3);
+
+    FifoCache cache{ vertexCount, cacheSize };
+    size_t scanCursor = 0;
+
+    // Finds somewhere to continue once the current fan has no good candidate left
+    auto skipDeadEnd = [&]() -> int64_t {
+        while (!deadEnds.empty()) {
+            const uint32_t vertex = deadEnds.back();
+            deadEnds.pop_back();
+            if (liveTriangles[vertex] > 0) {
+                return vertex;
+            }
+        }
+        while (scanCursor < vertexCount) {
+            if (liveTriangles[scanCursor] > 0) {
+                return static_cast<int64_t>(scanCursor);
+            }
+            scanCursor++;
+        }
+        return -1;
+    };
+
+    int64_t fanning = skipDeadEnd();
+    while (fanning >= 0) {
+        candidates.clear();
+
+        const uint32_t fanVertex = static_cast<uint32_t>(fanning);
+        for (uint32_t i = adjacency.offsets[fanVertex]; i < adjacency.offsets[fanVertex + 1]; i++) {
+            const uint32_t triangle = adjacency.triangles[i];
+            if (emitted[triangle]) {
+                continue;
+            }
+            emitted[triangle] = true;
+
+            for (uint32_t corner = 0; corner < 3; corner++) {
+                const uint32_t vertex = indices[triangle * 3 + corner];
+                result.push_back(vertex);
+                deadEnds.push_back(vertex);
+                candidates.push_back(vertex);
+                liveTriangles[vertex]--;
+                cache.Touch(vertex);
+            }
+        }
+
+        // Prefer the oldest candidate that will still be cached once all its triangles are out
+        int64_t next = -1;
+        int64_t bestPriority = -1;
+        for (uint32_t vertex : candidates) {
+            if (liveTriangles[vertex] == 0) {
+                continue;
+            }
+
+            int64_t priority = 0;
+            if (cache.Contains(vertex) && cache.Age(vertex) + 2 * liveTriangles[vertex] <= cacheSize) {
+                priority = cache.Age(vertex);
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = vertex;
+            }
+        }
+
+        fanning = next >= 0 ? next : skipDeadEnd();
+    }
+
+    // Anything past the last whole triangle is kept as it was
+    result.insert(result.end(), indices.begin() + triangleCount * 3, indices.end());
+    indices = std::move(result);
+}
+
+void MeshOptimizer::OptimizeOverdraw(
+        std::vector<uint32_t>& indices,
+        const glm::vec3* positions,
+        size_t positionStride,
+        size_t vertexCount,
+        float threshold,
+        uint32_t cacheSize) {
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    auto positionOf = [&](uint32_t vertex) -> const glm::vec3& {
+        return *reinterpret_cast<const glm::vec3*>(reinterpret_cast<const uint8_t*>(positions) + vertex * positionStride);
+    };
+
+    // 1. Hard boundaries: triangles that miss on all three vertices, where the cache order
+    //    started over and reordering costs nothing
+    FifoCache cache{ vertexCount, cacheSize };
+    std::vector<uint32_t> hardStarts{};
+    for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+        uint32_t misses = 0;
+        for (uint32_t corner = 0; corner < 3; corner++) {
+            misses += cache.Touch(indices[triangle * 3 + corner]) ? 1 : 0;
+        }
+        if (misses == 3 || triangle == 0) {
+            hardStarts.push_back(triangle);
+        }
+    }
+    hardStarts.push_back(static_cast<uint32_t>(triangleCount));
+
+    // 2. Soft boundaries: inside a hard cluster, cut as soon as the part so far is within
+    //    threshold of the cluster's own ACMR, restarting the cache there
+    std::vector<uint32_t> clusterStarts{};
+    for (size_t cluster = 0; cluster + 1 < hardStarts.size(); cluster++) {
+        const uint32_t begin = hardStarts[cluster];
+        const uint32_t end = hardStarts[cluster + 1];
+
+        cache.Clear();
+        uint32_t clusterMisses = 0;
+        for (uint32_t corner = begin * 3; corner < end * 3; corner++) {
+            clusterMisses += cache.Touch(indices[corner]) ? 1 : 0;
+        }
+        const float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - begin);
+
+        cache.Clear();
+        uint32_t start = begin;
+        uint32_t misses = 0;
+        clusterStarts.push_back(begin);
+        for (uint32_t triangle = begin; triangle < end; triangle++) {
+            for (uint32_t corner = 0; corner < 3; corner++) {
+                misses += cache.Touch(indices[triangle * 3 + corner]) ? 1 : 0;
+            }
+
+            if (triangle + 1 < end &&
+                static_cast<float>(misses) / static_cast<float>(triangle + 1 - start) <= clusterThreshold) {
+                start = triangle + 1;
+                misses = 0;
+                cache.Clear();
+                clusterStarts.push_back(start);
+            }
+        }
+    }
+    clusterStarts.push_back(static_cast<uint32_t>(triangleCount));
+
+    // 3. Area weighted centroid and normal per cluster, sorted so that clusters facing away
+    //    from the mesh centroid come first
+    const size_t clusterCount = clusterStarts.size() - 1;
+    std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3{ 0.0f });
+    std::vector<glm::vec3> clusterNormals(clusterCount, glm::vec3{ 0.0f });
+    glm::vec3 meshCentroid{ 0.0f };
+    float meshArea = 0.0f;
+
+    for (size_t cluster = 0; cluster < clusterCount; cluster++) {
+        float clusterArea = 0.0f;
+        for (uint32_t triangle = clusterStarts[cluster]; triangle < clusterStarts[cluster + 1]; triangle++) {
+            const glm::vec3& a = positionOf(indices[triangle * 3 + 0]);
+            const glm::vec3& b = positionOf(indices[triangle * 3 + 1]);
+            const glm::vec3& c = positionOf(indices[triangle * 3 + 2]);
+
+            const glm::vec3 normal = glm::cross(b - a, c - a);
+            const float area = glm::length(normal);
+
+            clusterCentroids[cluster] += (a + b + c) * (area / 3.0f);
+            clusterNormals[cluster] += normal;
+            clusterArea += area;
+        }
+
+        meshCentroid += clusterCentroids[cluster];
+        meshArea += clusterArea;
+        clusterCentroids[cluster] = clusterArea > 0.0f ? clusterCentroids[cluster] / clusterArea : glm::vec3{ 0.0f };
+    }
+    meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : glm::vec3{ 0.0f };
+
+    std::vector<float> scores(clusterCount);
+    for (size_t cluster = 0; cluster < clusterCount; cluster++) {
+        const float length = glm::length(clusterNormals[cluster]);
+        const glm::vec3 normal = length > 0.0f ? clusterNormals[cluster] / length : glm::vec3{ 0.0f };
+        scores[cluster] = glm::dot(clusterCentroids[cluster] - meshCentroid, normal);
+    }
+
+    std::vector<uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return scores[a] > scores[b]; });
+
+    std::vector<uint32_t> result{};
+    result.reserve(indices.size());
+    for (uint32_t cluster : order) {
+        result.insert(result.end(), indices.begin() + clusterStarts[cluster] * 3, indices.begin() + clusterStarts[cluster + 1] * 3);
+    }
+    result.insert(result.end(), indices.begin() + triangleCount * 3, indices.end());
+    indices = std::move(result);
+}
+
+std::vector<uint32_t> MeshOptimizer::OptimizeVertexFetch(std::vector<uint32_t>& indices, size_t vertexCount) {
+    constexpr uint32_t unassigned = UINT32_MAX;
+    std::vector<uint32_t> remap(vertexCount, unassigned);
+    std::vector<uint32_t> order{};
+
+    for (uint32_t& index : indices) {
+        if (remap[index] == unassigned) {
+            remap[index] = static_cast<uint32_t>(order.size());
+            order.push_back(index);
+        }
+        index = remap[index];
+    }
+
+    return order;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Reorders indexed triangle lists for the GPU without changing what gets rendered.
+// The intended order is OptimizeVertexCache, OptimizeOverdraw, then OptimizeVertexFetch.
+class MeshOptimizer {
+public:
+    // FIFO size assumed for the post-transform cache, both when optimizing and analyzing
+    static constexpr uint32_t s_CacheSize = 16;
+    // How much worse than the cache order a cluster may get to allow finer overdraw sorting
+    static constexpr float s_OverdrawThreshold = 1.05f;
+
+    struct CacheStats {
+        float acmr = 0.0f;  // transformed vertices per triangle, 3 at worst and about 0.5 at best
+        float atvr = 0.0f;  // transformed vertices per referenced vertex, 1 is optimal
+    };
+
+    struct Report {
+        CacheStats before{};
+        CacheStats after{};
+    };
+public:
+    static CacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize = s_CacheSize);
+
+    // Tipsify (Sander, Nehab and Barczak, 2007): fans around the vertex that is most likely
+    // still cached, jumping to a dead end only when the whole neighbourhood is used up
+    static void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount, uint32_t cacheSize = s_CacheSize);
+
+    // Splits the list into clusters where the cache order restarts anyway and draws the
+    // clusters facing away from the mesh center first, so outer surfaces occlude inner ones.
+    // positions holds vertexCount positions positionStride bytes apart.
+    static void OptimizeOverdraw(
+        std::vector<uint32_t>& indices,
+        const glm::vec3* positions,
+        size_t positionStride,
+        size_t vertexCount,
+        float threshold = s_OverdrawThreshold,
+        uint32_t cacheSize = s_CacheSize);
+
+    // Renumbers vertices in order of first use and rewrites indices to match. Returns the old
+    // index of every new vertex, unreferenced vertices are dropped.
+    static std::vector<uint32_t> OptimizeVertexFetch(std::vector<uint32_t>& indices, size_t vertexCount);
+};
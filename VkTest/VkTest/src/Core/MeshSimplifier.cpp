@@ -0,0 +1,332 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <queue>
+
+namespace {
+    // Symmetric 4x4 matrix, sum of squared distances to a set of planes
+    struct Quadric {
+        double a2 = 0.0, ab = 0.0, ac = 0.0, ad = 0.0;
+        double b2 = 0.0, bc = 0.0, bd = 0.0;
+        double c2 = 0.0, cd = 0.0;
+        double d2 = 0.0;
+
+        static Quadric FromPlane(const glm::dvec3& normal, double d, double weight) {
+            Quadric q{};
+            q.a2 = weight * normal.x * normal.x;
+            q.ab = weight * normal.x * normal.y;
+            q.ac = weight * normal.x * normal.z;
+            q.ad = weight * normal.x * d;
+            q.b2 = weight * normal.y * normal.y;
+            q.bc = weight * normal.y * normal.z;
+            q.bd = weight * normal.y * d;
+            q.c2 = weight * normal.z * normal.z;
+            q.cd = weight * normal.z * d;
+            q.d2 = weight * d * d;
+            return q;
+        }
+
+        Quadric& operator+=(const Quadric& other) {
+            a2 += other.a2; ab += other.ab; ac += other.ac; ad += other.ad;
+            b2 += other.b2; bc += other.bc; bd += other.bd;
+            c2 += other.c2; cd += other.cd;
+            d2 += other.d2;
+            return *this;
+        }
+
+        double Evaluate(const glm::dvec3& p) const {
+            return a2 * p.x * p.x + 2.0 * ab * p.x * p.y + 2.0 * ac * p.x * p.z + 2.0 * ad * p.x
+                 + b2 * p.y * p.y + 2.0 * bc * p.y * p.z + 2.0 * bd * p.y
+                 + c2 * p.z * p.z + 2.0 * cd * p.z
+                 + d2;
+        }
+    };
+
+    struct Collapse {
+        double   cost;
+        uint32_t from;
+        uint32_t to;
+        uint32_t fromVersion;
+        uint32_t toVersion;
+
+        bool operator>(const Collapse& other) const { return cost > other.cost; }
+    };
+
+    uint64_t EdgeKey(uint32_t a, uint32_t b) {
+        return a < b ? (static_cast<uint64_t>(a) << 32) | b : (static_cast<uint64_t>(b) << 32) | a;
+    }
+
+    float AttributeDistance(const Model::Vertex& a, const Model::Vertex& b) {
+        const glm::vec3 normal = a.normal - b.normal;
+        const glm::vec3 color = a.color - b.color;
+        const glm::vec2 uv = a.uv - b.uv;
+        return glm::dot(normal, normal) + glm::dot(color, color) + glm::dot(uv, uv);
+    }
+}
+
+MeshSimplifier::Result MeshSimplifier::Simplify(
+        const std::vector<uint32_t>& indices,
+        const std::vector<Model::Vertex>& vertices,
+        size_t targetIndexCount) {
+    Result result{};
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0 || indices.size() <= targetIndexCount) {
+        result.indices.assign(indices.begin(), indices.begin() + triangleCount * 3);
+        return result;
+    }
+
+    // 1. Weld vertices by position. Everything below works on welded ids, attributes only
+    //    come back in when the final index list is written.
+    std::vector<uint32_t> byPosition(vertices.size());
+    std::iota(byPosition.begin(), byPosition.end(), 0u);
+    std::sort(byPosition.begin(), byPosition.end(), [&](uint32_t a, uint32_t b) {
+        const glm::vec3& pa = vertices[a].position;
+        const glm::vec3& pb = vertices[b].position;
+        if (pa.x != pb.x) return pa.x < pb.x;
+        if (pa.y != pb.y) return pa.y < pb.y;
+        if (pa.z != pb.z) return pa.z < pb.z;
+        return a < b;
+    });
+
+    std::vector<uint32_t> welded(vertices.size());
+    std::vector<uint32_t> groupOffsets{};      // members of welded id i are byPosition[offsets[i], offsets[i + 1])
+    std::vector<glm::dvec3> positions{};
+    for (size_t i = 0; i < byPosition.size(); i++) {
+        const uint32_t vertex = byPosition[i];
+        if (i == 0 || vertices[vertex].position != vertices[byPosition[i - 1]].position) {
+            groupOffsets.push_back(static_cast<uint32_t>(i));
+            positions.push_back(glm::dvec3{ vertices[vertex].position });
+        }
+        welded[vertex] = static_cast<uint32_t>(positions.size() - 1);
+    }
+    groupOffsets.push_back(static_cast<uint32_t>(byPosition.size()));
+
+    const size_t pointCount = positions.size();
+    std::vector<uint32_t> triangles(triangleCount * 3);
+    for (size_t corner = 0; corner < triangles.size(); corner++) {
+        triangles[corner] = welded[indices[corner]];
+    }
+
+    // 2. Face planes weighted by area. Triangles already degenerate after welding are dropped.
+    std::vector<Quadric> quadrics(pointCount);
+    std::vector<bool> triangleAlive(triangleCount, true);
+    std::vector<std::vector<uint32_t>> pointTriangles(pointCount);
+    size_t aliveCount = 0;
+
+    for (uint32_t t = 0; t < triangleCount; t++) {
+        const uint32_t* tri = &triangles[t * 3];
+        if (tri[0] == tri[1] || tri[1] == tri[2] || tri[0] == tri[2]) {
+            triangleAlive[t] = false;
+            continue;
+        }
+
+        const glm::dvec3 cross = glm::cross(positions[tri[1]] - positions[tri[0]], positions[tri[2]] - positions[tri[0]]);
+        const double length = glm::length(cross);
+        if (length > 0.0) {
+            const glm::dvec3 normal = cross / length;
+            const Quadric plane = Quadric::FromPlane(normal, -glm::dot(normal, positions[tri[0]]), 0.5 * length);
+            for (uint32_t corner = 0; corner < 3; corner++) {
+                quadrics[tri[corner]] += plane;
+            }
+        }
+
+        for (uint32_t corner = 0; corner < 3; corner++) {
+            pointTriangles[tri[corner]].push_back(t);
+        }
+        aliveCount++;
+    }
+
+    // 3. Edges used by a single triangle are borders, they get a plane through the edge
+    //    perpendicular to the face
+    std::vector<uint64_t> edges{};
+    edges.reserve(aliveCount * 3);
+    for (uint32_t t = 0; t < triangleCount; t++) {
+        if (triangleAlive[t]) {
+            for (uint32_t corner = 0; corner < 3; corner++) {
+                edges.push_back(EdgeKey(triangles[t * 3 + corner], triangles[t * 3 + (corner + 1) % 3]));
+            }
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    for (uint32_t t = 0; t < triangleCount; t++) {
+        if (!triangleAlive[t]) {
+            continue;
+        }
+
+        const uint32_t* tri = &triangles[t * 3];
+        const glm::dvec3 faceNormal = glm::cross(positions[tri[1]] - positions[tri[0]], positions[tri[2]] - positions[tri[0]]);
+        for (uint32_t corner = 0; corner < 3; corner++) {
+            const uint32_t a = tri[corner];
+            const uint32_t b = tri[(corner + 1) % 3];
+            const auto range = std::equal_range(edges.begin(), edges.end(), EdgeKey(a, b));
+            if (range.second - range.first != 1) {
+                continue;
+            }
+
+            const glm::dvec3 edge = positions[b] - positions[a];
+            const glm::dvec3 perpendicular = glm::cross(edge, faceNormal);
+            const double length = glm::length(perpendicular);
+            if (length == 0.0) {
+                continue;
+            }
+
+            const glm::dvec3 normal = perpendicular / length;
+            const Quadric plane = Quadric::FromPlane(normal, -glm::dot(normal, positions[a]), s_BorderWeight * glm::dot(edge, edge));
+            quadrics[a] += plane;
+            quadrics[b] += plane;
+        }
+    }
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    // 4. Cheapest collapse first. Entries go stale when either end changes, which the
+    //    version stamps catch when they come off the queue.
+    std::vector<uint32_t> versions(pointCount, 0);
+    std::vector<uint32_t> parents(pointCount);
+    std::iota(parents.begin(), parents.end(), 0u);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue{};
+
+    auto pushEdge = [&](uint32_t a, uint32_t b) {
+        Quadric sum = quadrics[a];
+        sum += quadrics[b];
+        const double costToB = sum.Evaluate(positions[b]);
+        const double costToA = sum.Evaluate(positions[a]);
+        if (costToB <= costToA) {
+            queue.push({ costToB, a, b, versions[a], versions[b] });
+        }
+        else {
+            queue.push({ costToA, b, a, versions[b], versions[a] });
+        }
+    };
+
+    for (uint64_t edge : edges) {
+        pushEdge(static_cast<uint32_t>(edge >> 32), static_cast<uint32_t>(edge & 0xffffffffu));
+    }
+
+    // Moving from onto to must not turn any of from's remaining triangles around
+    auto flips = [&](uint32_t from, uint32_t to) {
+        for (uint32_t t : pointTriangles[from]) {
+            const uint32_t* tri = &triangles[t * 3];
+            if (!triangleAlive[t] || tri[0] == to || tri[1] == to || tri[2] == to) {
+                continue;
+            }
+
+            glm::dvec3 corners[3]{ positions[tri[0]], positions[tri[1]], positions[tri[2]] };
+            const glm::dvec3 before = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+            for (uint32_t corner = 0; corner < 3; corner++) {
+                if (tri[corner] == from) {
+                    corners[corner] = positions[to];
+                }
+            }
+            const glm::dvec3 after = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+            if (glm::dot(before, after) <= 0.0) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    const size_t targetTriangles = targetIndexCount / 3;
+    double maxCost = 0.0;
+
+    while (aliveCount > targetTriangles && !queue.empty()) {
+        const Collapse collapse = queue.top();
+        queue.pop();
+
+        if (parents[collapse.from] != collapse.from || parents[collapse.to] != collapse.to ||
+            versions[collapse.from] != collapse.fromVersion || versions[collapse.to] != collapse.toVersion) {
+            continue;
+        }
+        if (flips(collapse.from, collapse.to)) {
+            continue;
+        }
+
+        const uint32_t from = collapse.from;
+        const uint32_t to = collapse.to;
+        parents[from] = to;
+        quadrics[to] += quadrics[from];
+        versions[to]++;
+        maxCost = std::max(maxCost, collapse.cost);
+
+        for (uint32_t t : pointTriangles[from]) {
+            if (!triangleAlive[t]) {
+                continue;
+            }
+
+            uint32_t* tri = &triangles[t * 3];
+            if (tri[0] == to || tri[1] == to || tri[2] == to) {
+                triangleAlive[t] = false;
+                aliveCount--;
+                continue;
+            }
+
+            for (uint32_t corner = 0; corner < 3; corner++) {
+                if (tri[corner] == from) {
+                    tri[corner] = to;
+                }
+            }
+            pointTriangles[to].push_back(t);
+        }
+        pointTriangles[from].clear();
+        pointTriangles[from].shrink_to_fit();
+
+        auto& around = pointTriangles[to];
+        around.erase(std::remove_if(around.begin(), around.end(), [&](uint32_t t) { return !triangleAlive[t]; }), around.end());
+        for (uint32_t t : around) {
+            for (uint32_t corner = 0; corner < 3; corner++) {
+                if (triangles[t * 3 + corner] != to) {
+                    pushEdge(to, triangles[t * 3 + corner]);
+                }
+            }
+        }
+    }
+
+    // 5. Back to real vertices. A corner whose point was collapsed takes the vertex at the
+    //    surviving point that is closest in normal, color and uv.
+    auto find = [&](uint32_t point) {
+        while (parents[point] != point) {
+            parents[point] = parents[parents[point]];
+            point = parents[point];
+        }
+        return point;
+    };
+
+    constexpr uint32_t unresolved = UINT32_MAX;
+    std::vector<uint32_t> resolved(vertices.size(), unresolved);
+    auto resolve = [&](uint32_t vertex) {
+        if (resolved[vertex] != unresolved) {
+            return resolved[vertex];
+        }
+
+        const uint32_t point = find(welded[vertex]);
+        uint32_t best = vertex;
+        if (point != welded[vertex]) {
+            float bestDistance = INFINITY;
+            for (uint32_t i = groupOffsets[point]; i < groupOffsets[point + 1]; i++) {
+                const float distance = AttributeDistance(vertices[vertex], vertices[byPosition[i]]);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = byPosition[i];
+                }
+            }
+        }
+
+        resolved[vertex] = best;
+        return best;
+    };
+
+    result.indices.reserve(aliveCount * 3);
+    for (uint32_t t = 0; t < triangleCount; t++) {
+        if (!triangleAlive[t]) {
+            continue;
+        }
+        for (uint32_t corner = 0; corner < 3; corner++) {
+            result.indices.push_back(resolve(indices[t * 3 + corner]));
+        }
+    }
+
+    result.error = maxCost;
+    return result;
+}
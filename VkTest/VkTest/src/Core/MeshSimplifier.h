@@ -0,0 +1,29 @@
+#pragma once
+
+#include <Core/Model.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Quadric error metric edge collapse (Garland and Heckbert, 1997) restricted to collapsing
+// onto existing vertices, so a simplified level is only a new index list over the same
+// vertex buffer. Vertices sharing a position move together, which keeps normal and uv seams
+// closed. Borders are held in place by extra planes along them.
+class MeshSimplifier {
+public:
+    // Weight of the planes perpendicular to border edges, relative to the face planes
+    static constexpr double s_BorderWeight = 10.0;
+
+    struct Result {
+        std::vector<uint32_t> indices{};
+        double error = 0.0;     // largest collapse cost accepted, area weighted squared distance
+    };
+public:
+    // Collapses until at most targetIndexCount indices are left, or until every remaining
+    // collapse would fold a triangle over
+    static Result Simplify(
+        const std::vector<uint32_t>& indices,
+        const std::vector<Model::Vertex>& vertices,
+        size_t targetIndexCount);
+};
@@ -1,207 +1,563 @@
-#include "Model.h"
-#include <Core/Utils.h>
-
-#define TINYOBJLOADER_IMPLEMENTATION
-#include <tiny_obj_loader.h>
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtx/hash.hpp>
-
-#include <unordered_map>
-
-namespace std {
-    template <>
-    struct hash<Model::Vertex> {
-        size_t operator()(Model::Vertex const& vertex) const {
-            size_t seed{};
-            hashCombine(seed, vertex.position, vertex.color, vertex.normal, vertex.uv);
-            return seed;
-        }
-    };
-}
-
-std::vector<VkVertexInputBindingDescription> Model::Vertex::GetBindingDescriptions() {
-    return { {0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX} };
-}
-
-std::vector<VkVertexInputAttributeDescription> Model::Vertex::GetAttribDescriptions(){
-    return { 
-        {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, position)}, 
-        {1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, color)},
-        {2, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, normal)},
-        {3, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(Vertex, uv)}
-    };
-}
-
-bool Model::Vertex::operator==(const Vertex& other) const {
-    return position == other.position && 
-           color == other.color && 
-           normal == other.normal && 
-           uv == other.uv;
-}
-
-Model::Model(Device& device, const Model::Builder& builder)
-    : m_Device{device} {
-    CreateVertexBuffer(builder.vertices);
-    CreateIndexBuffer(builder.indices);
-}
-
-Model::~Model() {
-    vkDestroyBuffer(m_Device.GetDevice(), m_VertexBuffer, nullptr);
-    vkFreeMemory(m_Device.GetDevice(), m_VertexBufferMemory, nullptr);
-
-    if (m_HasIndexBuffer) {
-        vkDestroyBuffer(m_Device.GetDevice(), m_IndexBuffer, nullptr);
-        vkFreeMemory(m_Device.GetDevice(), m_IndexBufferMemory, nullptr);
-    }
-}
-
-void Model::Bind(VkCommandBuffer& cmdBuffer) {
-    VkBuffer buffers[]{ m_VertexBuffer };
-    VkDeviceSize offsets[]{ 0 };
-    vkCmdBindVertexBuffers(cmdBuffer, 0, 1, buffers, offsets);
-
-    if (m_HasIndexBuffer) {
-        vkCmdBindIndexBuffer(cmdBuffer, m_IndexBuffer, 0, VK_INDEX_TYPE_UINT32);
-    }
-}
-
-void Model::Draw(VkCommandBuffer& cmdBuffer) {
-    if (m_HasIndexBuffer) {
-        vkCmdDrawIndexed(cmdBuffer, m_IndexCount, 1, 0, 0, 0);
-    }
-    else {
-        vkCmdDraw(cmdBuffer, m_VertexCount, 1, 0, 0);
-    }
-}
-
-std::unique_ptr<Model> Model::CreateModel(Device& device, const std::string& filepath) {
-    Builder builder{};
-    builder.LoadModel(filepath);
-
-    return std::make_unique<Model>(device, builder);
-}
-
-void Model::CreateVertexBuffer(const std::vector<Vertex>& vertices) {
-    m_VertexCount = static_cast<uint32_t>(vertices.size());
-    VkDeviceSize bufferSize = sizeof(vertices[0]) * m_VertexCount;
-
-    VkBuffer stagingBuffer{};
-    VkDeviceMemory stagingBufferMemory{};
-    m_Device.CreateBuffer(
-        bufferSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        stagingBuffer,
-        stagingBufferMemory
-    );
-
-    void* data;
-    vkMapMemory(m_Device.GetDevice(), stagingBufferMemory, 0, bufferSize, 0, &data);
-    memcpy(data, vertices.data(), static_cast<size_t>(bufferSize));
-    vkUnmapMemory(m_Device.GetDevice(), stagingBufferMemory);
-
-    m_Device.CreateBuffer(
-        bufferSize,
-        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        m_VertexBuffer,
-        m_VertexBufferMemory);
-
-    m_Device.CopyBuffer(stagingBuffer, m_VertexBuffer, bufferSize);
-    vkDestroyBuffer(m_Device.GetDevice(), stagingBuffer, nullptr);
-    vkFreeMemory(m_Device.GetDevice(), stagingBufferMemory, nullptr);
-}
-
-void Model::CreateIndexBuffer(const std::vector<uint32_t>& indices) {
-    m_IndexCount = static_cast<uint32_t>(indices.size());
-    m_HasIndexBuffer = m_IndexCount > 0;
-
-    if (!m_HasIndexBuffer) {
-        return;
-    }
-
-    VkDeviceSize bufferSize = sizeof(indices[0]) * m_IndexCount;
-
-    VkBuffer stagingBuffer{};
-    VkDeviceMemory stagingBufferMemory{};
-    m_Device.CreateBuffer(
-        bufferSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-        stagingBuffer,
-        stagingBufferMemory
-    );
-
-    void* data;
-    vkMapMemory(m_Device.GetDevice(), stagingBufferMemory, 0, bufferSize, 0, &data);
-    memcpy(data, indices.data(), static_cast<size_t>(bufferSize));
-    vkUnmapMemory(m_Device.GetDevice(), stagingBufferMemory);
-
-    m_Device.CreateBuffer(
-        bufferSize,
-        VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        m_IndexBuffer,
-        m_IndexBufferMemory);
-
-    m_Device.CopyBuffer(stagingBuffer, m_IndexBuffer, bufferSize);
-    vkDestroyBuffer(m_Device.GetDevice(), stagingBuffer, nullptr);
-    vkFreeMemory(m_Device.GetDevice(), stagingBufferMemory, nullptr);
-}
-
-void Model::Builder::LoadModel(const std::string& filepath) {
-    tinyobj::attrib_t attrib;
-    std::vector<tinyobj::shape_t> shapes;
-    std::vector<tinyobj::material_t> materials;
-    std::string warn, err;
-
-    if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, filepath.c_str())) {
-        throw std::runtime_error(warn + err);
-    }
-
-    vertices.clear();
-    indices.clear();
-
-    std::unordered_map<Vertex, uint32_t> uniqueVertices{};
-    for (const auto& shape : shapes) {
-        for (const auto& index : shape.mesh.indices) {
-            Vertex vertex{};
-
-            if (index.vertex_index >= 0) {
-                vertex.position = {
-                    attrib.vertices[3 * index.vertex_index + 0],
-                    attrib.vertices[3 * index.vertex_index + 1],
-                    attrib.vertices[3 * index.vertex_index + 2]
-                };
-
-                vertex.color = {
-                    attrib.colors[3 * index.vertex_index + 0],
-                    attrib.colors[3 * index.vertex_index + 1],
-                    attrib.colors[3 * index.vertex_index + 2]
-                };
-            }
-
-            if (index.normal_index >= 0) {
-                vertex.normal = {
-                    attrib.normals[3 * index.normal_index + 0],
-                    attrib.normals[3 * index.normal_index + 1],
-                    attrib.normals[3 * index.normal_index + 2]
-                };
-            }
-
-            if (index.texcoord_index >= 0) {
-                vertex.uv = {
-                    attrib.texcoords[2 * index.texcoord_index + 0],
-                    attrib.texcoords[2 * index.texcoord_index + 1]
-                };
-            }
-
-            if (uniqueVertices.count(vertex) == 0) {
-                uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
-                vertices.push_back(vertex);
-            }
-
-            indices.push_back(uniqueVertices[vertex]);
-        }
-    }
-}
+#include "Model.h"
+#include <Core/MeshCache.h>
+#include <Core/MeshSimplifier.h>
+#include <Core/ThreadPool.h>
+#include <Core/Trace.h>
+
+#define TINYOBJLOADER_IMPLEMENTATION
+#include <tiny_obj_loader.h>
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <unordered_set>
+
+namespace {
+    void LogOptimizeReport(const std::string& filepath, const MeshOptimizer::Report& report) {
+        std::cout << "mesh optimize: " << filepath
+            << " ACMR " << report.before.acmr << " -> " << report.after.acmr
+            << ", ATVR " << report.before.atvr << " -> " << report.after.atvr << '\n';
+    }
+}
+
+std::vector<VkVertexInputBindingDescription> Model::Vertex::GetBindingDescriptions() {
+    return { {0, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX} };
+}
+
+std::vector<VkVertexInputAttributeDescription> Model::Vertex::GetAttribDescriptions(){
+    return { 
+        {0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, position)}, 
+        {1, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, color)},
+        {2, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, normal)},
+        {3, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(Vertex, uv)}
+    };
+}
+
+std::vector<VkVertexInputBindingDescription> Model::PackedVertex::GetBindingDescriptions() {
+    return { {0, sizeof(PackedVertex), VK_VERTEX_INPUT_RATE_VERTEX} };
+}
+
+std::vector<VkVertexInputAttributeDescription> Model::PackedVertex::GetAttribDescriptions() {
+    return {
+        {0, 0, VK_FORMAT_R16G16B16A16_SNORM, offsetof(PackedVertex, position)},
+        {1, 0, VK_FORMAT_R8G8B8A8_UNORM, offsetof(PackedVertex, color)},
+        {2, 0, VK_FORMAT_R16G16_SNORM, offsetof(PackedVertex, normal)},
+        {3, 0, VK_FORMAT_R16G16_SFLOAT, offsetof(PackedVertex, uv)}
+    };
+}
+
+// Projects onto the octahedron |x| + |y| + |z| = 1 and folds the lower half over the upper
+static glm::vec2 OctahedralEncode(const glm::vec3& normal) {
+    const float sum = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (sum == 0.0f) {
+        return glm::vec2{ 0.0f };
+    }
+
+    const glm::vec3 n = normal / sum;
+    if (n.z >= 0.0f) {
+        return glm::vec2{ n.x, n.y };
+    }
+    return glm::vec2{
+        (1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+        (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f) };
+}
+
+Model::PackedVertex Model::PackedVertex::Pack(const Vertex& vertex, const glm::vec3& center, const glm::vec3& halfExtent) {
+    PackedVertex packed{};
+
+    const uint64_t position = glm::packSnorm4x16(glm::vec4{ (vertex.position - center) / halfExtent, 0.0f });
+    std::memcpy(packed.position, &position, sizeof(packed.position));
+    packed.normal = glm::packSnorm2x16(OctahedralEncode(vertex.normal));
+    packed.color = glm::packUnorm4x8(glm::vec4{ vertex.color, 1.0f });
+    packed.uv = glm::packHalf2x16(vertex.uv);
+
+    return packed;
+}
+
+bool Model::Vertex::operator==(const Vertex& other) const {
+    return position == other.position && 
+           color == other.color && 
+           normal == other.normal && 
+           uv == other.uv;
+}
+
+Model::Model(Device& device, const Model::Builder& builder)
+    : m_Device{device} {
+    m_Bounds = builder.hasBounds ? builder.bounds : Builder::ComputeBounds(builder.vertices);
+    m_Format = builder.format;
+
+    std::vector<Builder::IndexChunk> computedChunks{};
+    if (!builder.hasIndexChunks) {
+        computedChunks = Builder::BuildIndexChunks(builder.vertices, builder.indices, builder.splitLargeMeshes);
+    }
+    const auto& chunks = builder.hasIndexChunks ? builder.indexChunks : computedChunks;
+
+    // Vertices in upload order. Split meshes get a copy of every vertex per chunk using it.
+    std::vector<Vertex> chunkVertices{};
+    const std::vector<Vertex>* vertices = &builder.vertices;
+
+    std::vector<uint16_t> indices16{};
+    std::vector<uint32_t> indices32{};
+    const void* indexData = nullptr;
+    uint32_t indexCount = 0;
+    VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+
+    // Simplified levels index the same vertices, which split meshes no longer have
+    const bool split = chunks.size() > 1 || (chunks.size() == 1 && !chunks[0].vertices.empty());
+    const size_t lodCount = split ? 1 : builder.lodIndices.size() + 1;
+    m_Lods.resize(lodCount);
+
+    if (!chunks.empty()) {
+        uint32_t vertexBase = 0;
+        for (const auto& chunk : chunks) {
+            m_Lods[0].submeshes.push_back({
+                static_cast<uint32_t>(indices16.size()),
+                static_cast<uint32_t>(chunk.indices.size()),
+                static_cast<int32_t>(vertexBase) });
+            indices16.insert(indices16.end(), chunk.indices.begin(), chunk.indices.end());
+
+            if (split) {
+                for (uint32_t vertex : chunk.vertices) {
+                    chunkVertices.push_back(builder.vertices[vertex]);
+                }
+                vertexBase += static_cast<uint32_t>(chunk.vertices.size());
+            }
+        }
+        if (split) {
+            vertices = &chunkVertices;
+        }
+
+        for (size_t lod = 1; lod < lodCount; lod++) {
+            const auto& lodIndices = builder.lodIndices[lod - 1];
+            m_Lods[lod].submeshes.push_back({ static_cast<uint32_t>(indices16.size()), static_cast<uint32_t>(lodIndices.size()), 0 });
+            for (uint32_t index : lodIndices) {
+                indices16.push_back(static_cast<uint16_t>(index));
+            }
+        }
+
+        indexData = indices16.data();
+        indexCount = static_cast<uint32_t>(indices16.size());
+        indexType = VK_INDEX_TYPE_UINT16;
+    }
+    else {
+        // Everything goes through the indexed path, so unindexed input gets a trivial index list
+        if (builder.indices.empty()) {
+            indices32.resize(builder.vertices.size());
+            for (uint32_t i = 0; i < indices32.size(); i++) {
+                indices32[i] = i;
+            }
+        }
+        else if (lodCount > 1) {
+            indices32 = builder.indices;
+        }
+        const auto& indices = indices32.empty() ? builder.indices : indices32;
+        m_Lods[0].submeshes.push_back({ 0, static_cast<uint32_t>(indices.size()), 0 });
+
+        for (size_t lod = 1; lod < lodCount; lod++) {
+            const auto& lodIndices = builder.lodIndices[lod - 1];
+            m_Lods[lod].submeshes.push_back({ static_cast<uint32_t>(indices32.size()), static_cast<uint32_t>(lodIndices.size()), 0 });
+            indices32.insert(indices32.end(), lodIndices.begin(), lodIndices.end());
+        }
+
+        indexData = indices.data();
+        indexCount = static_cast<uint32_t>(indices.size());
+    }
+
+    // Only the packed vertices need to exist on the CPU side, the upload copies them out
+    std::vector<PackedVertex> packedVertices{};
+    const void* vertexData = vertices->data();
+    uint32_t vertexStride = sizeof(Vertex);
+
+    if (m_Format == VertexFormat::Packed) {
+        const glm::vec3 center = 0.5f * (m_Bounds.min + m_Bounds.max);
+        // Flat meshes have a zero extent on some axis, any scale decodes them correctly there
+        const glm::vec3 extent = 0.5f * (m_Bounds.max - m_Bounds.min);
+        const glm::vec3 halfExtent = glm::max(extent, glm::vec3{ 1e-6f });
+
+        // The cull sphere lives in stored vertex space. Measured there directly instead of
+        // rescaling the object space one, which would divide by the 1e-6 extent of flat meshes.
+        const glm::vec3 storedCenter = (glm::vec3{ m_Bounds.sphere } - center) / halfExtent;
+        float radiusSquared = 0.0f;
+
+        packedVertices.reserve(vertices->size());
+        for (const auto& vertex : *vertices) {
+            packedVertices.push_back(PackedVertex::Pack(vertex, center, halfExtent));
+
+            const glm::vec3 d = (vertex.position - center) / halfExtent - storedCenter;
+            radiusSquared = std::max(radiusSquared, glm::dot(d, d));
+        }
+        // Plus the snorm16 rounding of every axis
+        m_DrawSphere = glm::vec4{ storedCenter, std::sqrt(radiusSquared) + std::sqrt(3.0f) / 32767.0f };
+
+        m_Dequantize = glm::mat4{
+            glm::vec4{ halfExtent.x, 0.0f, 0.0f, 0.0f },
+            glm::vec4{ 0.0f, halfExtent.y, 0.0f, 0.0f },
+            glm::vec4{ 0.0f, 0.0f, halfExtent.z, 0.0f },
+            glm::vec4{ center, 1.0f } };
+        vertexData = packedVertices.data();
+        vertexStride = sizeof(PackedVertex);
+    }
+
+    m_pGeometryPool = &m_Device.GetGeometryPool(vertexStride);
+    m_Geometry = m_pGeometryPool->Allocate(static_cast<uint32_t>(vertices->size()), indexCount, indexType);
+    m_UploadTicket = m_pGeometryPool->Upload(m_Geometry, vertexData, indexData);
+
+    std::vector<uint32_t> lodIndexCounts(m_Lods.size(), 0);
+    for (size_t lod = 0; lod < m_Lods.size(); lod++) {
+        for (auto& submesh : m_Lods[lod].submeshes) {
+            submesh.firstIndex += m_Geometry.firstIndex;
+            submesh.vertexOffset += m_Geometry.vertexOffset;
+            lodIndexCounts[lod] += submesh.indexCount;
+        }
+    }
+    for (size_t lod = 0; lod < m_Lods.size(); lod++) {
+        m_Lods[lod].triangleRatio = static_cast<float>(lodIndexCounts[lod]) / static_cast<float>(std::max(lodIndexCounts[0], 1u));
+    }
+}
+
+Model::~Model() {
+    m_Device.GetUploadManager().Wait(m_UploadTicket);
+    m_pGeometryPool->Free(m_Geometry);
+}
+
+void Model::Bind(VkCommandBuffer& cmdBuffer) {
+    m_pGeometryPool->Bind(cmdBuffer, m_Geometry.page, m_Geometry.indexType);
+}
+
+void Model::Draw(VkCommandBuffer& cmdBuffer, uint32_t instanceCount, uint32_t firstInstance, uint32_t lod) {
+    for (const auto& submesh : m_Lods[lod].submeshes) {
+        vkCmdDrawIndexed(
+            cmdBuffer,
+            submesh.indexCount,
+            instanceCount,
+            submesh.firstIndex,
+            submesh.vertexOffset,
+            firstInstance);
+    }
+}
+
+glm::mat4 Model::GetDrawMatrix(const glm::mat4& world) const {
+    return m_Format == VertexFormat::Full ? world : world * m_Dequantize;
+}
+
+std::unique_ptr<Model> Model::CreateModel(Device& device, const std::string& filepath, VertexFormat format) {
+    Builder builder{};
+    if (const auto report = builder.LoadModel(filepath)) {
+        LogOptimizeReport(filepath, *report);
+    }
+    builder.format = format;
+
+    return std::make_unique<Model>(device, builder);
+}
+
+std::vector<std::unique_ptr<Model>> Model::CreateModels(
+        Device& device,
+        const std::vector<std::string>& filepaths,
+        VertexFormat format) {
+    std::vector<Builder> builders(filepaths.size());
+    std::vector<std::optional<MeshOptimizer::Report>> reports(filepaths.size());
+    ThreadPool::Get().ParallelFor(filepaths.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            reports[i] = builders[i].LoadModel(filepaths[i]);
+            builders[i].format = format;
+        }
+    });
+
+    // Logged here rather than on the loader threads, where lines would interleave
+    for (size_t i = 0; i < reports.size(); i++) {
+        if (reports[i]) {
+            LogOptimizeReport(filepaths[i], *reports[i]);
+        }
+    }
+
+    std::vector<std::unique_ptr<Model>> models{};
+    models.reserve(builders.size());
+    for (const auto& builder : builders) {
+        models.push_back(std::make_unique<Model>(device, builder));
+    }
+
+    return models;
+}
+
+std::optional<MeshOptimizer::Report> Model::Builder::LoadModel(const std::string& filepath) {
+    TRACE_ZONE("Model::Builder::LoadModel");
+    const uint64_t sourceHash = MeshCache::HashFile(filepath);
+    const std::string cachePath = MeshCache::GetCachePath(filepath);
+
+    std::optional<MeshOptimizer::Report> report{};
+    const bool cached = MeshCache::Load(cachePath, sourceHash, *this);
+    if (!cached) {
+        {
+            TRACE_ZONE("Model::Builder::ParseObj");
+            ParseObj(filepath);
+        }
+
+        if (optimize) {
+            report = Optimize();
+        }
+    }
+
+    bounds = ComputeBounds(vertices);
+    hasBounds = true;
+
+    indexChunks = BuildIndexChunks(vertices, indices, splitLargeMeshes);
+    hasIndexChunks = true;
+
+    // Cached meshes come with their levels of detail, simplifying is the slowest step of a load
+    if (!cached) {
+        if (indexChunks.size() <= 1) {
+            TRACE_ZONE("Model::Builder::BuildLods");
+            BuildLods();
+        }
+        MeshCache::Save(cachePath, sourceHash, *this);
+    }
+
+    return report;
+}
+
+void Model::Builder::BuildLods() {
+    lodIndices.clear();
+    if (indices.size() < 3) {
+        return;
+    }
+
+    // Each level starts from the one before, which is cheaper than starting over and nests them
+    lodIndices.reserve(lodRatios.size());
+    const std::vector<uint32_t>* previous = &indices;
+    for (float ratio : lodRatios) {
+        const size_t target = static_cast<size_t>(static_cast<double>(indices.size()) * ratio) / 3 * 3;
+        MeshSimplifier::Result level = MeshSimplifier::Simplify(*previous, vertices, target);
+
+        // Stuck on borders or fold-overs, further levels would only repeat this one
+        if (level.indices.empty() || level.indices.size() * 20 > previous->size() * 19) {
+            break;
+        }
+
+        MeshOptimizer::OptimizeVertexCache(level.indices, vertices.size());
+        lodIndices.push_back(std::move(level.indices));
+        previous = &lodIndices.back();
+    }
+}
+
+MeshOptimizer::Report Model::Builder::Optimize() {
+    TRACE_ZONE("Model::Builder::Optimize");
+    MeshOptimizer::Report report{};
+    if (indices.size() < 3) {
+        return report;
+    }
+
+    report.before = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+
+    MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+    MeshOptimizer::OptimizeOverdraw(indices, &vertices[0].position, sizeof(Vertex), vertices.size());
+
+    const std::vector<uint32_t> order = MeshOptimizer::OptimizeVertexFetch(indices, vertices.size());
+    std::vector<Vertex> reordered(order.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        reordered[i] = vertices[order[i]];
+    }
+    vertices = std::move(reordered);
+
+    report.after = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+    return report;
+}
+
+Model::Bounds Model::Builder::ComputeBounds(const std::vector<Vertex>& vertices) {
+    Bounds bounds{};
+    if (vertices.empty()) {
+        return bounds;
+    }
+
+    bounds.min = vertices[0].position;
+    bounds.max = vertices[0].position;
+    for (const auto& vertex : vertices) {
+        bounds.min = glm::min(bounds.min, vertex.position);
+        bounds.max = glm::max(bounds.max, vertex.position);
+    }
+
+    // Centered on the box, which is never far off the minimal sphere for the meshes we load
+    const glm::vec3 center = 0.5f * (bounds.min + bounds.max);
+    float radiusSquared = 0.0f;
+    for (const auto& vertex : vertices) {
+        const glm::vec3 d = vertex.position - center;
+        radiusSquared = std::max(radiusSquared, glm::dot(d, d));
+    }
+
+    bounds.sphere = glm::vec4{ center, std::sqrt(radiusSquared) };
+    return bounds;
+}
+
+std::vector<Model::Builder::IndexChunk> Model::Builder::BuildIndexChunks(
+        const std::vector<Vertex>& vertices,
+        const std::vector<uint32_t>& indices,
+        bool splitLargeMeshes) {
+    const size_t indexCount = indices.empty() ? vertices.size() : indices.size();
+    auto indexAt = [&](size_t i) { return indices.empty() ? static_cast<uint32_t>(i) : indices[i]; };
+
+    std::vector<IndexChunk> chunks{};
+    if (vertices.size() <= s_MaxChunkVertices) {
+        IndexChunk& chunk = chunks.emplace_back();
+        chunk.indices.resize(indexCount);
+        for (size_t i = 0; i < indexCount; i++) {
+            chunk.indices[i] = static_cast<uint16_t>(indexAt(i));
+        }
+        return chunks;
+    }
+
+    if (!splitLargeMeshes) {
+        return chunks;
+    }
+
+    // Triangles are taken in order and a new chunk starts whenever one would not fit.
+    // Index order is kept, so whatever locality the source had survives inside each chunk.
+    constexpr uint32_t unassigned = UINT32_MAX;
+    std::vector<uint32_t> localIndex(vertices.size(), unassigned);
+
+    for (size_t first = 0; first + 3 <= indexCount; first += 3) {
+        uint32_t newVertices = 0;
+        for (size_t corner = first; corner < first + 3; corner++) {
+            newVertices += localIndex[indexAt(corner)] == unassigned ? 1 : 0;
+        }
+
+        if (chunks.empty() || chunks.back().vertices.size() + newVertices > s_MaxChunkVertices) {
+            if (!chunks.empty()) {
+                for (uint32_t vertex : chunks.back().vertices) {
+                    localIndex[vertex] = unassigned;
+                }
+            }
+            chunks.emplace_back();
+        }
+
+        IndexChunk& chunk = chunks.back();
+        for (size_t corner = first; corner < first + 3; corner++) {
+            const uint32_t vertex = indexAt(corner);
+            if (localIndex[vertex] == unassigned) {
+                localIndex[vertex] = static_cast<uint32_t>(chunk.vertices.size());
+                chunk.vertices.push_back(vertex);
+            }
+            chunk.indices.push_back(static_cast<uint16_t>(localIndex[vertex]));
+        }
+    }
+
+    return chunks;
+}
+
+void Model::Builder::ParseObj(const std::string& filepath) {
+    tinyobj::attrib_t attrib;
+    std::vector<tinyobj::shape_t> shapes;
+    std::vector<tinyobj::material_t> materials;
+    std::string warn, err;
+
+    if (!tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, filepath.c_str())) {
+        throw std::runtime_error(warn + err);
+    }
+
+    vertices.clear();
+    indices.clear();
+
+    std::vector<const tinyobj::index_t*> corners{};
+    for (const auto& shape : shapes) {
+        for (const auto& index : shape.mesh.indices) {
+            corners.push_back(&index);
+        }
+    }
+
+    const size_t cornerCount = corners.size();
+    if (cornerCount == 0) {
+        return;
+    }
+
+    auto& pool = ThreadPool::Get();
+    const size_t chunkCount = std::min<size_t>(
+        pool.GetThreadCount() * 4,
+        (cornerCount + s_MinCornersPerChunk - 1) / s_MinCornersPerChunk);
+    const size_t grainSize = (cornerCount + chunkCount - 1) / chunkCount;
+
+    // 1. Expand every face corner into a full vertex and bucket it by hash shard.
+    //    Buckets are per chunk, so each shard later sees its corners in ascending order.
+    std::vector<Vertex> cornerVertices(cornerCount);
+    std::vector<size_t> cornerHashes(cornerCount);
+    std::vector<std::vector<std::vector<uint32_t>>> chunkShards(
+        chunkCount, 
+        std::vector<std::vector<uint32_t>>(s_DedupShardCount));
+
+    pool.ParallelFor(cornerCount, grainSize, [&](size_t begin, size_t end) {
+        auto& shards = chunkShards[begin / grainSize];
+        for (size_t c = begin; c < end; c++) {
+            const auto& index = *corners[c];
+            Vertex& vertex = cornerVertices[c];
+
+            if (index.vertex_index >= 0) {
+                vertex.position = {
+                    attrib.vertices[3 * index.vertex_index + 0],
+                    attrib.vertices[3 * index.vertex_index + 1],
+                    attrib.vertices[3 * index.vertex_index + 2]
+                };
+
+                vertex.color = {
+                    attrib.colors[3 * index.vertex_index + 0],
+                    attrib.colors[3 * index.vertex_index + 1],
+                    attrib.colors[3 * index.vertex_index + 2]
+                };
+            }
+
+            if (index.normal_index >= 0) {
+                vertex.normal = {
+                    attrib.normals[3 * index.normal_index + 0],
+                    attrib.normals[3 * index.normal_index + 1],
+                    attrib.normals[3 * index.normal_index + 2]
+                };
+            }
+
+            if (index.texcoord_index >= 0) {
+                vertex.uv = {
+                    attrib.texcoords[2 * index.texcoord_index + 0],
+                    attrib.texcoords[2 * index.texcoord_index + 1]
+                };
+            }
+
+            cornerHashes[c] = std::hash<Vertex>{}(vertex);
+            shards[cornerHashes[c] % s_DedupShardCount].push_back(static_cast<uint32_t>(c));
+        }
+    });
+
+    // 2. Each shard is owned by exactly one task, so no locking is needed. For every corner
+    //    record the first corner holding an identical vertex.
+    struct CornerHash {
+        const std::vector<size_t>* hashes;
+        size_t operator()(uint32_t c) const { return (*hashes)[c]; }
+    };
+    struct CornerEqual {
+        const std::vector<Vertex>* vertices;
+        bool operator()(uint32_t a, uint32_t b) const { return (*vertices)[a] == (*vertices)[b]; }
+    };
+
+    std::vector<uint32_t> firstCorner(cornerCount);
+    pool.ParallelFor(s_DedupShardCount, 1, [&](size_t begin, size_t end) {
+        for (size_t shard = begin; shard < end; shard++) {
+            std::unordered_set<uint32_t, CornerHash, CornerEqual> unique{
+                0, 
+                CornerHash{ &cornerHashes }, 
+                CornerEqual{ &cornerVertices } };
+
+            for (const auto& shards : chunkShards) {
+                for (uint32_t c : shards[shard]) {
+                    firstCorner[c] = *unique.insert(c).first;
+                }
+            }
+        }
+    });
+
+    // 3. Number unique vertices by first appearance, which gives the same order as a serial walk.
+    std::vector<uint32_t> remap(cornerCount);
+    indices.resize(cornerCount);
+    for (size_t c = 0; c < cornerCount; c++) {
+        if (firstCorner[c] == c) {
+            remap[c] = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(cornerVertices[c]);
+        }
+        indices[c] = remap[firstCorner[c]];
+    }
+}
@@ -1,60 +1,177 @@
-#pragma once
-
-#include <Core/Device.h>
-
-#define GLM_FORCE_RADIANS
-#define GLM_FORCE_DEPTH_ZERO_TO_ONE
-#include <glm/glm.hpp>
-
-#include <memory>
-#include <vector>
-
-class Model{
-public:
-    struct Vertex {
-        glm::vec3 position{};
-        glm::vec3 color{};
-        glm::vec3 normal{};
-        glm::vec2 uv{};
-
-        static std::vector<VkVertexInputBindingDescription> GetBindingDescriptions();
-        static std::vector<VkVertexInputAttributeDescription> GetAttribDescriptions();
-
-        bool operator==(const Vertex& other) const;
-    };
-
-    struct Builder {
-        std::vector<Vertex> vertices{};
-        std::vector<uint32_t> indices{};
-
-        void LoadModel(const std::string& filepath);
-    };
-public:
-    Model(Device& device, const Model::Builder& builder);
-    ~Model();
-
-    Model(const Model&) = delete;
-    Model& operator=(const Model&) = delete;
-
-    Model(Model&&) = delete;
-    Model& operator=(Model&&) = delete;
-public:
-    void Bind(VkCommandBuffer& cmdBuffer);
-    void Draw(VkCommandBuffer& cmdBuffer);
-    static std::unique_ptr<Model> CreateModel(Device& device, const std::string& filepath);
-private:
-    void CreateVertexBuffer(const std::vector<Vertex>& vertices);
-    void CreateIndexBuffer(const std::vector<uint32_t>& indices);
-private:
-    Device&			m_Device;
-
-    VkBuffer		m_VertexBuffer;
-    VkDeviceMemory	m_VertexBufferMemory;
-    uint32_t		m_VertexCount;
-
-    VkBuffer		m_IndexBuffer;
-    VkDeviceMemory	m_IndexBufferMemory;
-    uint32_t		m_IndexCount;
-
-    bool m_HasIndexBuffer = false;
-};
\ No newline at end of file
+#pragma once
+
+#include <Core/Device.h>
+#include <Core/MeshOptimizer.h>
+#include <Core/Utils.h>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/hash.hpp>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+class Model{
+public:
+    // How a model's vertices are stored. Each format has its own geometry pool and pipelines.
+    enum class VertexFormat : uint32_t {
+        Full,       // Vertex
+        Packed      // PackedVertex
+    };
+    static constexpr uint32_t s_VertexFormatCount = 2;
+
+    struct Vertex {
+        glm::vec3 position{};
+        glm::vec3 color{};
+        glm::vec3 normal{};
+        glm::vec2 uv{};
+
+        static std::vector<VkVertexInputBindingDescription> GetBindingDescriptions();
+        static std::vector<VkVertexInputAttributeDescription> GetAttribDescriptions();
+
+        bool operator==(const Vertex& other) const;
+    };
+
+    // Object space bounds
+    struct Bounds {
+        glm::vec3 min{ 0.0f };
+        glm::vec3 max{ 0.0f };
+        glm::vec4 sphere{ 0.0f };   // xyz center, w radius
+    };
+
+    // 20 bytes instead of 44. Positions are snorm16 in [-1, 1] across the mesh AABB, the
+    // transform back to object space is folded into the model matrix at draw time.
+    struct PackedVertex {
+        int16_t  position[4];   // w unused
+        uint32_t normal;        // octahedral, snorm16 x2
+        uint32_t color;         // unorm8 x4
+        uint32_t uv;            // half x2
+
+        static std::vector<VkVertexInputBindingDescription> GetBindingDescriptions();
+        static std::vector<VkVertexInputAttributeDescription> GetAttribDescriptions();
+
+        static PackedVertex Pack(const Vertex& vertex, const glm::vec3& center, const glm::vec3& halfExtent);
+    };
+
+    struct Builder {
+        static constexpr size_t s_DedupShardCount = 64;
+        static constexpr size_t s_MinCornersPerChunk = 4096;
+        static constexpr size_t s_MaxChunkVertices = 1u << 16;
+
+        // A run of triangles whose indices fit in 16 bits
+        struct IndexChunk {
+            std::vector<uint32_t> vertices{};   // into Builder::vertices, empty means all of them in order
+            std::vector<uint16_t> indices{};
+        };
+
+        std::vector<Vertex> vertices{};
+        std::vector<uint32_t> indices{};
+        Bounds bounds{};
+        bool hasBounds = false;
+        VertexFormat format = VertexFormat::Full;
+
+        // Empty means the mesh is drawn with 32 bit indices
+        std::vector<IndexChunk> indexChunks{};
+        bool hasIndexChunks = false;
+        // Split meshes with more than s_MaxChunkVertices vertices instead of using 32 bit indices
+        bool splitLargeMeshes = true;
+        // Run Optimize() on freshly parsed meshes, the result is what gets cached
+        bool optimize = true;
+
+        // Triangle count targets of the simplified levels relative to the full mesh, finest first
+        std::vector<float> lodRatios{ 0.5f, 0.25f, 0.125f };
+        // Index lists of levels 1 and up over the same vertices, level 0 is indices. Filled by
+        // BuildLods(), which LoadModel calls for every mesh that is not split into chunks and
+        // stores in the mesh cache.
+        std::vector<std::vector<uint32_t>> lodIndices{};
+
+        // Returns the Optimize() stats when the mesh was parsed and optimized, not read from the cache
+        std::optional<MeshOptimizer::Report> LoadModel(const std::string& filepath);
+        void ParseObj(const std::string& filepath);
+        // Reorders triangles for the vertex cache, then for overdraw, then renumbers vertices
+        // in order of use. Returns the cache stats before and after.
+        MeshOptimizer::Report Optimize();
+        void BuildLods();
+        static Bounds ComputeBounds(const std::vector<Vertex>& vertices);
+        static std::vector<IndexChunk> BuildIndexChunks(
+            const std::vector<Vertex>& vertices,
+            const std::vector<uint32_t>& indices,
+            bool splitLargeMeshes);
+    };
+
+    // One vkCmdDrawIndexed worth of a model, absolute within its geometry pool page
+    struct Submesh {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        int32_t  vertexOffset;
+    };
+
+    // Level of detail, level 0 is the full mesh
+    struct Lod {
+        std::vector<Submesh> submeshes{};
+        float triangleRatio = 1.0f;     // triangles relative to level 0
+    };
+public:
+    Model(Device& device, const Model::Builder& builder);
+    ~Model();
+
+    Model(const Model&) = delete;
+    Model& operator=(const Model&) = delete;
+
+    Model(Model&&) = delete;
+    Model& operator=(Model&&) = delete;
+public:
+    void Bind(VkCommandBuffer& cmdBuffer);
+    void Draw(VkCommandBuffer& cmdBuffer, uint32_t instanceCount = 1, uint32_t firstInstance = 0, uint32_t lod = 0);
+    bool IsReady() const { return m_Device.GetUploadManager().IsReady(m_UploadTicket); }
+
+    const GeometryRange& GetGeometry() const { return m_Geometry; }
+    // A single entry unless the mesh was split into 16 bit index chunks
+    const std::vector<Submesh>& GetSubmeshes(uint32_t lod = 0) const { return m_Lods[lod].submeshes; }
+    uint32_t GetLodCount() const { return static_cast<uint32_t>(m_Lods.size()); }
+    const Lod& GetLod(uint32_t lod) const { return m_Lods[lod]; }
+    GeometryPool& GetGeometryPool() const { return *m_pGeometryPool; }
+    const Bounds& GetBounds() const { return m_Bounds; }
+    // Object space, xyz center and w radius
+    const glm::vec4& GetBoundingSphere() const { return m_Bounds.sphere; }
+
+    VertexFormat GetVertexFormat() const { return m_Format; }
+    // Maps stored vertex positions to object space, identity unless the format is Packed
+    const glm::mat4& GetDequantizeMatrix() const { return m_Dequantize; }
+    // Model matrix to draw with, world * dequantize
+    glm::mat4 GetDrawMatrix(const glm::mat4& world) const;
+    // Bounding sphere in stored vertex space, conservative for Packed
+    const glm::vec4& GetDrawBoundingSphere() const { return m_Format == VertexFormat::Packed ? m_DrawSphere : m_Bounds.sphere; }
+
+    static std::unique_ptr<Model> CreateModel(Device& device, const std::string& filepath, VertexFormat format = VertexFormat::Full);
+    static std::vector<std::unique_ptr<Model>> CreateModels(
+        Device& device,
+        const std::vector<std::string>& filepaths,
+        VertexFormat format = VertexFormat::Full);
+private:
+    Device&			m_Device;
+    GeometryPool*	m_pGeometryPool;
+    GeometryRange	m_Geometry;
+    std::vector<Lod>	m_Lods{};
+    Bounds			m_Bounds{};
+    VertexFormat	m_Format = VertexFormat::Full;
+    glm::mat4		m_Dequantize{ 1.0f };
+    glm::vec4		m_DrawSphere{ 0.0f };     // only set for Packed
+
+    UploadManager::Ticket m_UploadTicket = 0;
+};
+
+// Vertex deduplication key, used by ParseObj
+namespace std {
+    template <>
+    struct hash<Model::Vertex> {
+        size_t operator()(Model::Vertex const& vertex) const {
+            size_t seed{};
+            hashCombine(seed, vertex.position, vertex.color, vertex.normal, vertex.uv);
+            return seed;
+        }
+    };
+}
\ No newline at end of file
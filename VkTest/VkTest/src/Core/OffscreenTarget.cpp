@@ -0,0 +1,312 @@
+#include "OffscreenTarget.h"
+#include <Core/Trace.h>
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+OffscreenTarget::OffscreenTarget(Device& deviceRef, VkExtent2D extent)
+    : m_Device{ deviceRef }, m_Extent{ extent } {
+    if (extent.width == 0 || extent.height == 0) {
+        throw std::runtime_error("Offscreen target extent must not be empty!");
+    }
+
+    m_DepthFormat = FindDepthFormat();
+    CreateRenderPass();
+    CreateImages();
+    CreateFramebuffers();
+    CreateSyncObjects();
+}
+
+OffscreenTarget::~OffscreenTarget() {
+    for (auto framebuffer : m_Framebuffers) {
+        vkDestroyFramebuffer(m_Device.GetDevice(), framebuffer, nullptr);
+    }
+
+    for (size_t i = 0; i < m_ColorImages.size(); i++) {
+        vkDestroyImageView(m_Device.GetDevice(), m_ColorImageViews[i], nullptr);
+        m_Device.DestroyImage(m_ColorImages[i], m_ColorImageMemorys[i]);
+        vkDestroyImageView(m_Device.GetDevice(), m_DepthImageViews[i], nullptr);
+        m_Device.DestroyImage(m_DepthImages[i], m_DepthImageMemorys[i]);
+    }
+
+    vkDestroyRenderPass(m_Device.GetDevice(), m_RenderPass, nullptr);
+
+    for (auto fence : m_InFlightFences) {
+        vkDestroyFence(m_Device.GetDevice(), fence, nullptr);
+    }
+}
+
+VkResult OffscreenTarget::AcquireNextImage(uint32_t* imageIndex) {
+    TRACE_ZONE("OffscreenTarget::WaitForFrameFence");
+    vkWaitForFences(
+        m_Device.GetDevice(),
+        1,
+        &m_InFlightFences[m_CurrentFrame],
+        VK_TRUE,
+        std::numeric_limits<uint64_t>::max());
+
+    // Each frame in flight owns its images, so there is nothing to wait for beyond the fence
+    *imageIndex = static_cast<uint32_t>(m_CurrentFrame);
+    return VK_SUCCESS;
+}
+
+VkResult OffscreenTarget::SubmitCommandBuffers(const VkCommandBuffer* buffers, uint32_t* imageIndex) {
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = buffers;
+
+    vkResetFences(m_Device.GetDevice(), 1, &m_InFlightFences[m_CurrentFrame]);
+    if (vkQueueSubmit(m_Device.GraphicsQueue(), 1, &submitInfo, m_InFlightFences[m_CurrentFrame]) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit draw command buffer!");
+    }
+
+    m_LastSubmitted = *imageIndex;
+    m_CurrentFrame = (m_CurrentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+
+    return VK_SUCCESS;
+}
+
+void OffscreenTarget::ReadPixels(std::vector<uint8_t>& pixels) {
+    if (m_LastSubmitted < 0) {
+        throw std::runtime_error("No offscreen frame has been rendered yet!");
+    }
+
+    const uint32_t image = static_cast<uint32_t>(m_LastSubmitted);
+    vkWaitForFences(m_Device.GetDevice(), 1, &m_InFlightFences[image], VK_TRUE, std::numeric_limits<uint64_t>::max());
+
+    const VkDeviceSize size = static_cast<VkDeviceSize>(m_Extent.width) * m_Extent.height * 4;
+    VkBuffer stagingBuffer;
+    MemoryAllocation stagingMemory;
+    m_Device.CreateBuffer(
+        size,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        stagingBuffer,
+        stagingMemory);
+
+    VkCommandBuffer commandBuffer = m_Device.BeginSingleTimeCommands();
+
+    // The render pass left the image in TRANSFER_SRC, this only orders the copy after its writes
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = m_ColorImages[image];
+    barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        0, nullptr,
+        0, nullptr,
+        1, &barrier);
+
+    VkBufferImageCopy region{};
+    region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    region.imageExtent = { m_Extent.width, m_Extent.height, 1 };
+    vkCmdCopyImageToBuffer(
+        commandBuffer,
+        m_ColorImages[image],
+        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+        stagingBuffer,
+        1,
+        &region);
+
+    // Makes the copy visible to the host once the queue is idle
+    VkBufferMemoryBarrier hostBarrier{};
+    hostBarrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    hostBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hostBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    hostBarrier.buffer = stagingBuffer;
+    hostBarrier.size = VK_WHOLE_SIZE;
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_HOST_BIT,
+        0,
+        0, nullptr,
+        1, &hostBarrier,
+        0, nullptr);
+
+    m_Device.EndSingleTimeCommands(commandBuffer);
+
+    pixels.resize(static_cast<size_t>(size));
+    std::memcpy(pixels.data(), stagingMemory.mappedData, pixels.size());
+
+    m_Device.DestroyBuffer(stagingBuffer, stagingMemory);
+}
+
+void OffscreenTarget::CreateRenderPass() {
+    VkAttachmentDescription depthAttachment{};
+    depthAttachment.format = m_DepthFormat;
+    depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    VkAttachmentReference depthAttachmentRef{};
+    depthAttachmentRef.attachment = 1;
+    depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    // Ends up ready to be copied out instead of presented
+    VkAttachmentDescription colorAttachment = {};
+    colorAttachment.format = s_ColorFormat;
+    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    VkAttachmentReference colorAttachmentRef = {};
+    colorAttachmentRef.attachment = 0;
+    colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkSubpassDescription subpass = {};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colorAttachmentRef;
+    subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+    VkSubpassDependency dependency = {};
+    dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependency.srcAccessMask = 0;
+    dependency.srcStageMask =
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependency.dstSubpass = 0;
+    dependency.dstStageMask =
+        VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependency.dstAccessMask =
+        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+    std::array<VkAttachmentDescription, 2> attachments = { colorAttachment, depthAttachment };
+    VkRenderPassCreateInfo renderPassInfo = {};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+    renderPassInfo.pAttachments = attachments.data();
+    renderPassInfo.subpassCount = 1;
+    renderPassInfo.pSubpasses = &subpass;
+    renderPassInfo.dependencyCount = 1;
+    renderPassInfo.pDependencies = &dependency;
+
+    if (vkCreateRenderPass(m_Device.GetDevice(), &renderPassInfo, nullptr, &m_RenderPass) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create render pass!");
+    }
+}
+
+void OffscreenTarget::CreateImages() {
+    m_ColorImages.resize(MAX_FRAMES_IN_FLIGHT);
+    m_ColorImageMemorys.resize(MAX_FRAMES_IN_FLIGHT);
+    m_ColorImageViews.resize(MAX_FRAMES_IN_FLIGHT);
+    m_DepthImages.resize(MAX_FRAMES_IN_FLIGHT);
+    m_DepthImageMemorys.resize(MAX_FRAMES_IN_FLIGHT);
+    m_DepthImageViews.resize(MAX_FRAMES_IN_FLIGHT);
+
+    auto createImage = [&](VkFormat format, VkImageUsageFlags usage, VkImageAspectFlags aspect,
+            VkImage& image, MemoryAllocation& memory, VkImageView& view) {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = m_Extent.width;
+        imageInfo.extent.height = m_Extent.height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = format;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = usage;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.flags = 0;
+
+        m_Device.CreateImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, image, memory);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = image;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = format;
+        viewInfo.subresourceRange.aspectMask = aspect;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        if (vkCreateImageView(m_Device.GetDevice(), &viewInfo, nullptr, &view) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create texture image view!");
+        }
+    };
+
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        createImage(
+            s_ColorFormat,
+            VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+            VK_IMAGE_ASPECT_COLOR_BIT,
+            m_ColorImages[i],
+            m_ColorImageMemorys[i],
+            m_ColorImageViews[i]);
+        createImage(
+            m_DepthFormat,
+            VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
+            VK_IMAGE_ASPECT_DEPTH_BIT,
+            m_DepthImages[i],
+            m_DepthImageMemorys[i],
+            m_DepthImageViews[i]);
+    }
+}
+
+void OffscreenTarget::CreateFramebuffers() {
+    m_Framebuffers.resize(ImageCount());
+    for (size_t i = 0; i < ImageCount(); i++) {
+        std::array<VkImageView, 2> attachments = { m_ColorImageViews[i], m_DepthImageViews[i] };
+
+        VkFramebufferCreateInfo framebufferInfo = {};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = m_RenderPass;
+        framebufferInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+        framebufferInfo.pAttachments = attachments.data();
+        framebufferInfo.width = m_Extent.width;
+        framebufferInfo.height = m_Extent.height;
+        framebufferInfo.layers = 1;
+
+        if (vkCreateFramebuffer(m_Device.GetDevice(), &framebufferInfo, nullptr, &m_Framebuffers[i]) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create framebuffer!");
+        }
+    }
+}
+
+void OffscreenTarget::CreateSyncObjects() {
+    m_InFlightFences.resize(MAX_FRAMES_IN_FLIGHT);
+
+    VkFenceCreateInfo fenceInfo = {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    for (size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        if (vkCreateFence(m_Device.GetDevice(), &fenceInfo, nullptr, &m_InFlightFences[i]) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create synchronization objects for a frame!");
+        }
+    }
+}
+
+VkFormat OffscreenTarget::FindDepthFormat() {
+    return m_Device.FindSupportedFormat(
+        { VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT },
+        VK_IMAGE_TILING_OPTIMAL,
+        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Device.h"
+#include "SwapChain.h"
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <vector>
+
+// Stands in for the swap chain when there is no window. One color and depth image per frame
+// in flight, so the CPU can record the next frame while the previous one renders.
+// The render pass matches the swap chain's apart from the color format and final layout.
+class OffscreenTarget {
+public:
+    static constexpr int MAX_FRAMES_IN_FLIGHT = SwapChain::MAX_FRAMES_IN_FLIGHT;
+    static constexpr VkFormat s_ColorFormat = VK_FORMAT_R8G8B8A8_SRGB;
+public:
+    OffscreenTarget(Device& deviceRef, VkExtent2D extent);
+    ~OffscreenTarget();
+
+    OffscreenTarget(const OffscreenTarget&) = delete;
+    void operator=(const OffscreenTarget&) = delete;
+
+    OffscreenTarget(OffscreenTarget&&) = delete;
+    void operator=(OffscreenTarget&&) = delete;
+public:
+    VkFramebuffer GetFrameBuffer(int index) { return m_Framebuffers[index]; }
+    VkRenderPass GetRenderPass() { return m_RenderPass; }
+    VkImage GetImage(int index) { return m_ColorImages[index]; }
+    size_t ImageCount() { return m_ColorImages.size(); }
+    VkFormat GetImageFormat() { return s_ColorFormat; }
+    VkExtent2D GetExtent() { return m_Extent; }
+
+    float ExtentAspectRatio() {
+        return static_cast<float>(m_Extent.width) / static_cast<float>(m_Extent.height);
+    }
+    VkFormat FindDepthFormat();
+
+    // Same contract as the swap chain, waits for the frame's fence and never goes out of date
+    VkResult AcquireNextImage(uint32_t* imageIndex);
+    VkResult SubmitCommandBuffers(const VkCommandBuffer* buffers, uint32_t* imageIndex);
+
+    // Tightly packed RGBA8 of the last submitted frame, waits for it to finish rendering
+    void ReadPixels(std::vector<uint8_t>& pixels);
+private:
+    void CreateRenderPass();
+    void CreateImages();
+    void CreateFramebuffers();
+    void CreateSyncObjects();
+private:
+    Device&						m_Device;
+    VkExtent2D					m_Extent;
+    VkFormat					m_DepthFormat;
+    VkRenderPass				m_RenderPass;
+
+    std::vector<VkImage>		m_ColorImages;
+    std::vector<MemoryAllocation> m_ColorImageMemorys;
+    std::vector<VkImageView>	m_ColorImageViews;
+    std::vector<VkImage>		m_DepthImages;
+    std::vector<MemoryAllocation> m_DepthImageMemorys;
+    std::vector<VkImageView>	m_DepthImageViews;
+    std::vector<VkFramebuffer>	m_Framebuffers;
+
+    std::vector<VkFence>		m_InFlightFences;
+    size_t						m_CurrentFrame = 0;
+    int64_t						m_LastSubmitted = -1;
+};
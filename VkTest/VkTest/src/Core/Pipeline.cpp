@@ -1,203 +1,236 @@
-#include "Pipeline.h"
-
-#include <Core/Model.h>
-
-#include <fstream>
-
-PipelineConfigInfo::PipelineConfigInfo()
-    : viewportInfo{},
-    inputAssemblyInfo{},
-    rasterizationInfo{},
-    multisampleInfo{},
-    colorBlendAttachment{},
-    colorBlendInfo{},
-    depthStencilInfo{},
-    dynamicStateEnables{},
-    dynamicStateInfo{},
-    pipelineLayout{ nullptr },
-    renderPass{ nullptr },
-    subpass{ 0 } {}
-
-
-Pipeline::Pipeline(
-    Device& device,
-    const std::string& vertFilePath,
-    const std::string& fragFilePath,
-    const PipelineConfigInfo& info
-) : m_Device{ device } {
-    CreatePipeline(vertFilePath, fragFilePath, info);
-}
-
-Pipeline::~Pipeline() {
-    vkDestroyShaderModule(m_Device.GetDevice(), m_VertShaderModule, nullptr);
-    vkDestroyShaderModule(m_Device.GetDevice(), m_FragShaderModule, nullptr);
-    vkDestroyPipeline(m_Device.GetDevice(), m_GraphicsPipeline, nullptr);
-}
-
-// TODO: Check refs
-void Pipeline::Bind(VkCommandBuffer& cmdBuffer) {
-    vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_GraphicsPipeline);
-}
-
-void Pipeline::DefaultPipelineConfigInfo(PipelineConfigInfo& configInfo) {
-    //PipelineConfigInfo configInfo{};
-
-    configInfo.inputAssemblyInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-    configInfo.inputAssemblyInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-    configInfo.inputAssemblyInfo.primitiveRestartEnable = VK_FALSE;
-
-    configInfo.viewportInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-    configInfo.viewportInfo.viewportCount = 1;
-    configInfo.viewportInfo.pViewports = nullptr;
-    configInfo.viewportInfo.scissorCount = 1;
-    configInfo.viewportInfo.pScissors = nullptr;
-
-    configInfo.rasterizationInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-    configInfo.rasterizationInfo.depthClampEnable = VK_FALSE;
-    configInfo.rasterizationInfo.rasterizerDiscardEnable = VK_FALSE;
-    configInfo.rasterizationInfo.polygonMode = VK_POLYGON_MODE_FILL;
-    configInfo.rasterizationInfo.lineWidth = 1.0f;
-    configInfo.rasterizationInfo.cullMode = VK_CULL_MODE_NONE;
-    configInfo.rasterizationInfo.frontFace = VK_FRONT_FACE_CLOCKWISE;
-    configInfo.rasterizationInfo.depthBiasEnable = VK_FALSE;
-    configInfo.rasterizationInfo.depthBiasConstantFactor = 0.0f;  // Optional
-    configInfo.rasterizationInfo.depthBiasClamp = 0.0f;           // Optional
-    configInfo.rasterizationInfo.depthBiasSlopeFactor = 0.0f;     // Optional
-
-    configInfo.multisampleInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-    configInfo.multisampleInfo.sampleShadingEnable = VK_FALSE;
-    configInfo.multisampleInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-    configInfo.multisampleInfo.minSampleShading = 1.0f;           // Optional
-    configInfo.multisampleInfo.pSampleMask = nullptr;             // Optional
-    configInfo.multisampleInfo.alphaToCoverageEnable = VK_FALSE;  // Optional
-    configInfo.multisampleInfo.alphaToOneEnable = VK_FALSE;       // Optional
-
-    configInfo.colorBlendAttachment.colorWriteMask =
-        VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
-        VK_COLOR_COMPONENT_A_BIT;
-    configInfo.colorBlendAttachment.blendEnable = VK_FALSE;
-    configInfo.colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;   // Optional
-    configInfo.colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;  // Optional
-    configInfo.colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;              // Optional
-    configInfo.colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;   // Optional
-    configInfo.colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;  // Optional
-    configInfo.colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;              // Optional
-
-    configInfo.colorBlendInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-    configInfo.colorBlendInfo.logicOpEnable = VK_FALSE;
-    configInfo.colorBlendInfo.logicOp = VK_LOGIC_OP_COPY;  // Optional
-    configInfo.colorBlendInfo.attachmentCount = 1;
-    configInfo.colorBlendInfo.pAttachments = &configInfo.colorBlendAttachment;
-    configInfo.colorBlendInfo.blendConstants[0] = 0.0f;  // Optional
-    configInfo.colorBlendInfo.blendConstants[1] = 0.0f;  // Optional
-    configInfo.colorBlendInfo.blendConstants[2] = 0.0f;  // Optional
-    configInfo.colorBlendInfo.blendConstants[3] = 0.0f;  // Optional
-
-    configInfo.depthStencilInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-    configInfo.depthStencilInfo.depthTestEnable = VK_TRUE;
-    configInfo.depthStencilInfo.depthWriteEnable = VK_TRUE;
-    configInfo.depthStencilInfo.depthCompareOp = VK_COMPARE_OP_LESS;
-    configInfo.depthStencilInfo.depthBoundsTestEnable = VK_FALSE;
-    configInfo.depthStencilInfo.minDepthBounds = 0.0f;  // Optional
-    configInfo.depthStencilInfo.maxDepthBounds = 1.0f;  // Optional
-    configInfo.depthStencilInfo.stencilTestEnable = VK_FALSE;
-    configInfo.depthStencilInfo.front = {};  // Optional
-    configInfo.depthStencilInfo.back = {};   // Optional
-
-    configInfo.dynamicStateEnables = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
-    configInfo.dynamicStateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-    configInfo.dynamicStateInfo.pDynamicStates = configInfo.dynamicStateEnables.data();
-    configInfo.dynamicStateInfo.dynamicStateCount =
-        static_cast<uint32_t>(configInfo.dynamicStateEnables.size());
-    configInfo.dynamicStateInfo.flags = 0;
-}
-
-std::vector<char> Pipeline::ReadFile(const std::string& filePath) {
-    std::ifstream file{ filePath, std::ios_base::ate | std::ios_base::binary };
-
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file:" + filePath);
-    }
-
-    size_t fileSize = static_cast<size_t>(file.tellg());
-    std::vector<char> buffer(fileSize);
-
-    file.seekg(0);
-    file.read(buffer.data(), fileSize);
-
-    file.close();
-    return buffer;
-}
-
-void Pipeline::CreatePipeline(
-    const std::string& vertFilePath, 
-    const std::string& fragFilePath,
-    const PipelineConfigInfo& info
-) {
-    auto vertCode = ReadFile(vertFilePath);
-    auto fragCode = ReadFile(fragFilePath);
-
-    CreateShaderModule(vertCode, &m_VertShaderModule);
-    CreateShaderModule(fragCode, &m_FragShaderModule);
-
-    VkPipelineShaderStageCreateInfo shaderStages[2]{};
-    shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-    shaderStages[0].module = m_VertShaderModule;
-    shaderStages[0].pName = "main";
-    shaderStages[0].flags = 0;
-    shaderStages[0].pNext = nullptr;
-    shaderStages[0].pSpecializationInfo = nullptr;
-
-    shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    shaderStages[1].module = m_FragShaderModule;
-    shaderStages[1].pName = "main";
-    shaderStages[1].flags = 0;
-    shaderStages[1].pNext = nullptr;
-    shaderStages[1].pSpecializationInfo = nullptr;
-
-    auto bindingDesc = Model::Vertex::GetBindingDescriptions();
-    auto attribDesc = Model::Vertex::GetAttribDescriptions();
-    VkPipelineVertexInputStateCreateInfo vertexInfo{};
-    vertexInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attribDesc.size());
-    vertexInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDesc.size());
-    vertexInfo.pVertexAttributeDescriptions = attribDesc.data();
-    vertexInfo.pVertexBindingDescriptions = bindingDesc.data();
-
-    VkGraphicsPipelineCreateInfo pipelineInfo{};
-    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-    pipelineInfo.stageCount = 2;
-    pipelineInfo.pStages = shaderStages;
-    pipelineInfo.pVertexInputState = &vertexInfo;
-    pipelineInfo.pInputAssemblyState = &info.inputAssemblyInfo;
-    pipelineInfo.pViewportState = &info.viewportInfo;
-    pipelineInfo.pRasterizationState = &info.rasterizationInfo;
-    pipelineInfo.pMultisampleState = &info.multisampleInfo;
-    pipelineInfo.pColorBlendState = &info.colorBlendInfo;
-    pipelineInfo.pDepthStencilState = &info.depthStencilInfo;
-    pipelineInfo.pDynamicState = &info.dynamicStateInfo;
-
-    pipelineInfo.layout = info.pipelineLayout;
-    pipelineInfo.renderPass = info.renderPass;
-    pipelineInfo.subpass = info.subpass;
-
-    pipelineInfo.basePipelineIndex = -1;
-    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
-
-    if (vkCreateGraphicsPipelines(m_Device.GetDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &m_GraphicsPipeline) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create graphics pipeline!");
-    }
-}
-
-void Pipeline::CreateShaderModule(const std::vector<char>& code, VkShaderModule* shaderModule) {
-    VkShaderModuleCreateInfo createInfo{};
-    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = code.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
-
-    if (vkCreateShaderModule(m_Device.GetDevice(), &createInfo, nullptr, shaderModule) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create shader module!");
-    }
+#include "Pipeline.h"
+
+#include <Core/Model.h>
+
+#include <fstream>
+
+PipelineConfigInfo::PipelineConfigInfo()
+    : bindingDescriptions{},
+    attributeDescriptions{},
+    viewportInfo{},
+    inputAssemblyInfo{},
+    rasterizationInfo{},
+    multisampleInfo{},
+    colorBlendAttachment{},
+    colorBlendInfo{},
+    depthStencilInfo{},
+    dynamicStateEnables{},
+    dynamicStateInfo{},
+    pipelineLayout{ nullptr },
+    renderPass{ nullptr },
+    subpass{ 0 } {}
+
+
+Pipeline::Pipeline(
+    Device& device,
+    const std::string& vertFilePath,
+    const std::string& fragFilePath,
+    const PipelineConfigInfo& info
+) : m_Device{ device } {
+    CreatePipeline(vertFilePath, fragFilePath, info);
+}
+
+Pipeline::Pipeline(
+    Device& device,
+    const std::string& compFilePath,
+    VkPipelineLayout pipelineLayout
+) : m_Device{ device }, m_BindPoint{ VK_PIPELINE_BIND_POINT_COMPUTE } {
+    CreateComputePipeline(compFilePath, pipelineLayout);
+}
+
+Pipeline::~Pipeline() {
+    vkDestroyShaderModule(m_Device.GetDevice(), m_VertShaderModule, nullptr);
+    vkDestroyShaderModule(m_Device.GetDevice(), m_FragShaderModule, nullptr);
+    vkDestroyShaderModule(m_Device.GetDevice(), m_CompShaderModule, nullptr);
+    vkDestroyPipeline(m_Device.GetDevice(), m_GraphicsPipeline, nullptr);
+}
+
+// TODO: Check refs
+void Pipeline::Bind(VkCommandBuffer& cmdBuffer) {
+    vkCmdBindPipeline(cmdBuffer, m_BindPoint, m_GraphicsPipeline);
+}
+
+void Pipeline::DefaultPipelineConfigInfo(PipelineConfigInfo& configInfo) {
+    //PipelineConfigInfo configInfo{};
+
+    configInfo.inputAssemblyInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+    configInfo.inputAssemblyInfo.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    configInfo.inputAssemblyInfo.primitiveRestartEnable = VK_FALSE;
+
+    configInfo.viewportInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+    configInfo.viewportInfo.viewportCount = 1;
+    configInfo.viewportInfo.pViewports = nullptr;
+    configInfo.viewportInfo.scissorCount = 1;
+    configInfo.viewportInfo.pScissors = nullptr;
+
+    configInfo.rasterizationInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+    configInfo.rasterizationInfo.depthClampEnable = VK_FALSE;
+    configInfo.rasterizationInfo.rasterizerDiscardEnable = VK_FALSE;
+    configInfo.rasterizationInfo.polygonMode = VK_POLYGON_MODE_FILL;
+    configInfo.rasterizationInfo.lineWidth = 1.0f;
+    configInfo.rasterizationInfo.cullMode = VK_CULL_MODE_NONE;
+    configInfo.rasterizationInfo.frontFace = VK_FRONT_FACE_CLOCKWISE;
+    configInfo.rasterizationInfo.depthBiasEnable = VK_FALSE;
+    configInfo.rasterizationInfo.depthBiasConstantFactor = 0.0f;  // Optional
+    configInfo.rasterizationInfo.depthBiasClamp = 0.0f;           // Optional
+    configInfo.rasterizationInfo.depthBiasSlopeFactor = 0.0f;     // Optional
+
+    configInfo.multisampleInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+    configInfo.multisampleInfo.sampleShadingEnable = VK_FALSE;
+    configInfo.multisampleInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+    configInfo.multisampleInfo.minSampleShading = 1.0f;           // Optional
+    configInfo.multisampleInfo.pSampleMask = nullptr;             // Optional
+    configInfo.multisampleInfo.alphaToCoverageEnable = VK_FALSE;  // Optional
+    configInfo.multisampleInfo.alphaToOneEnable = VK_FALSE;       // Optional
+
+    configInfo.colorBlendAttachment.colorWriteMask =
+        VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT |
+        VK_COLOR_COMPONENT_A_BIT;
+    configInfo.colorBlendAttachment.blendEnable = VK_FALSE;
+    configInfo.colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_ONE;   // Optional
+    configInfo.colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;  // Optional
+    configInfo.colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;              // Optional
+    configInfo.colorBlendAttachment.srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;   // Optional
+    configInfo.colorBlendAttachment.dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;  // Optional
+    configInfo.colorBlendAttachment.alphaBlendOp = VK_BLEND_OP_ADD;              // Optional
+
+    configInfo.colorBlendInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+    configInfo.colorBlendInfo.logicOpEnable = VK_FALSE;
+    configInfo.colorBlendInfo.logicOp = VK_LOGIC_OP_COPY;  // Optional
+    configInfo.colorBlendInfo.attachmentCount = 1;
+    configInfo.colorBlendInfo.pAttachments = &configInfo.colorBlendAttachment;
+    configInfo.colorBlendInfo.blendConstants[0] = 0.0f;  // Optional
+    configInfo.colorBlendInfo.blendConstants[1] = 0.0f;  // Optional
+    configInfo.colorBlendInfo.blendConstants[2] = 0.0f;  // Optional
+    configInfo.colorBlendInfo.blendConstants[3] = 0.0f;  // Optional
+
+    configInfo.depthStencilInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    configInfo.depthStencilInfo.depthTestEnable = VK_TRUE;
+    configInfo.depthStencilInfo.depthWriteEnable = VK_TRUE;
+    configInfo.depthStencilInfo.depthCompareOp = VK_COMPARE_OP_LESS;
+    configInfo.depthStencilInfo.depthBoundsTestEnable = VK_FALSE;
+    configInfo.depthStencilInfo.minDepthBounds = 0.0f;  // Optional
+    configInfo.depthStencilInfo.maxDepthBounds = 1.0f;  // Optional
+    configInfo.depthStencilInfo.stencilTestEnable = VK_FALSE;
+    configInfo.depthStencilInfo.front = {};  // Optional
+    configInfo.depthStencilInfo.back = {};   // Optional
+
+    configInfo.dynamicStateEnables = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+    configInfo.dynamicStateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+    configInfo.dynamicStateInfo.pDynamicStates = configInfo.dynamicStateEnables.data();
+    configInfo.dynamicStateInfo.dynamicStateCount =
+        static_cast<uint32_t>(configInfo.dynamicStateEnables.size());
+    configInfo.dynamicStateInfo.flags = 0;
+
+    configInfo.bindingDescriptions = Model::Vertex::GetBindingDescriptions();
+    configInfo.attributeDescriptions = Model::Vertex::GetAttribDescriptions();
+}
+
+std::vector<char> Pipeline::ReadFile(const std::string& filePath) {
+    std::ifstream file{ filePath, std::ios_base::ate | std::ios_base::binary };
+
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file:" + filePath);
+    }
+
+    size_t fileSize = static_cast<size_t>(file.tellg());
+    std::vector<char> buffer(fileSize);
+
+    file.seekg(0);
+    file.read(buffer.data(), fileSize);
+
+    file.close();
+    return buffer;
+}
+
+void Pipeline::CreatePipeline(
+    const std::string& vertFilePath, 
+    const std::string& fragFilePath,
+    const PipelineConfigInfo& info
+) {
+    auto vertCode = ReadFile(vertFilePath);
+    auto fragCode = ReadFile(fragFilePath);
+
+    CreateShaderModule(vertCode, &m_VertShaderModule);
+    CreateShaderModule(fragCode, &m_FragShaderModule);
+
+    VkPipelineShaderStageCreateInfo shaderStages[2]{};
+    shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
+    shaderStages[0].module = m_VertShaderModule;
+    shaderStages[0].pName = "main";
+    shaderStages[0].flags = 0;
+    shaderStages[0].pNext = nullptr;
+    shaderStages[0].pSpecializationInfo = nullptr;
+
+    shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+    shaderStages[1].module = m_FragShaderModule;
+    shaderStages[1].pName = "main";
+    shaderStages[1].flags = 0;
+    shaderStages[1].pNext = nullptr;
+    shaderStages[1].pSpecializationInfo = nullptr;
+
+    auto& bindingDesc = info.bindingDescriptions;
+    auto& attribDesc = info.attributeDescriptions;
+    VkPipelineVertexInputStateCreateInfo vertexInfo{};
+    vertexInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    vertexInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attribDesc.size());
+    vertexInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDesc.size());
+    vertexInfo.pVertexAttributeDescriptions = attribDesc.data();
+    vertexInfo.pVertexBindingDescriptions = bindingDesc.data();
+
+    VkGraphicsPipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+    pipelineInfo.stageCount = 2;
+    pipelineInfo.pStages = shaderStages;
+    pipelineInfo.pVertexInputState = &vertexInfo;
+    pipelineInfo.pInputAssemblyState = &info.inputAssemblyInfo;
+    pipelineInfo.pViewportState = &info.viewportInfo;
+    pipelineInfo.pRasterizationState = &info.rasterizationInfo;
+    pipelineInfo.pMultisampleState = &info.multisampleInfo;
+    pipelineInfo.pColorBlendState = &info.colorBlendInfo;
+    pipelineInfo.pDepthStencilState = &info.depthStencilInfo;
+    pipelineInfo.pDynamicState = &info.dynamicStateInfo;
+
+    pipelineInfo.layout = info.pipelineLayout;
+    pipelineInfo.renderPass = info.renderPass;
+    pipelineInfo.subpass = info.subpass;
+
+    pipelineInfo.basePipelineIndex = -1;
+    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+
+    if (vkCreateGraphicsPipelines(m_Device.GetDevice(), m_Device.GetPipelineCache(), 1, &pipelineInfo, nullptr, &m_GraphicsPipeline) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create graphics pipeline!");
+    }
+}
+
+void Pipeline::CreateComputePipeline(const std::string& compFilePath, VkPipelineLayout pipelineLayout) {
+    auto compCode = ReadFile(compFilePath);
+    CreateShaderModule(compCode, &m_CompShaderModule);
+
+    VkComputePipelineCreateInfo pipelineInfo{};
+    pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = m_CompShaderModule;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.layout = pipelineLayout;
+    pipelineInfo.basePipelineIndex = -1;
+    pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+
+    if (vkCreateComputePipelines(m_Device.GetDevice(), m_Device.GetPipelineCache(), 1, &pipelineInfo, nullptr, &m_GraphicsPipeline) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create compute pipeline!");
+    }
+}
+
+void Pipeline::CreateShaderModule(const std::vector<char>& code, VkShaderModule* shaderModule) {
+    VkShaderModuleCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+    createInfo.codeSize = code.size();
+    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+
+    if (vkCreateShaderModule(m_Device.GetDevice(), &createInfo, nullptr, shaderModule) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create shader module!");
+    }
 }
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "PipelineCache.h"
+#include <Core/Utils.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+PipelineCache::PipelineCache(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::string& filepath)
+    : m_Device{ device }, m_Properties{ properties }, m_Filepath{ filepath } {
+    std::vector<char> data{};
+
+    std::ifstream file{ m_Filepath, std::ios::ate | std::ios::binary };
+    if (file.is_open()) {
+        const size_t fileSize = static_cast<size_t>(file.tellg());
+        Header header{};
+        if (fileSize >= sizeof(Header)) {
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(&header), sizeof(Header));
+        }
+
+        if (header.magic == s_Magic &&
+            header.version == s_Version &&
+            header.dataSize == fileSize - sizeof(Header)) {
+            data.resize(static_cast<size_t>(header.dataSize));
+            file.read(data.data(), data.size());
+
+            if (!file.good() || hashBytes(data.data(), data.size()) != header.dataHash || !IsCompatible(data.data(), data.size())) {
+                data.clear();
+            }
+        }
+    }
+
+    if (data.empty() && file.is_open()) {
+        std::cout << "pipeline cache: discarding " << m_Filepath << std::endl;
+    }
+
+    VkPipelineCacheCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.initialDataSize = data.size();
+    createInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+    if (vkCreatePipelineCache(m_Device, &createInfo, nullptr, &m_Cache) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create pipeline cache!");
+    }
+}
+
+PipelineCache::~PipelineCache() {
+    Save();
+    vkDestroyPipelineCache(m_Device, m_Cache, nullptr);
+}
+
+bool PipelineCache::Save() const {
+    size_t size = 0;
+    if (vkGetPipelineCacheData(m_Device, m_Cache, &size, nullptr) != VK_SUCCESS || size == 0) {
+        return false;
+    }
+
+    std::vector<char> data(size);
+    if (vkGetPipelineCacheData(m_Device, m_Cache, &size, data.data()) != VK_SUCCESS) {
+        return false;
+    }
+    data.resize(size);
+
+    Header header{};
+    header.magic = s_Magic;
+    header.version = s_Version;
+    header.dataSize = data.size();
+    header.dataHash = hashBytes(data.data(), data.size());
+
+    return writeFileAtomic(m_Filepath, { { &header, sizeof(Header) }, { data.data(), data.size() } });
+}
+
+bool PipelineCache::IsCompatible(const void* data, size_t size) const {
+    VkPipelineCacheHeaderVersionOne header{};
+    if (size < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+
+    // A driver update changes the UUID, the blob is useless to the new one
+    return header.headerSize >= sizeof(header) &&
+           header.headerSize <= size &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == m_Properties.vendorID &&
+           header.deviceID == m_Properties.deviceID &&
+           memcmp(header.pipelineCacheUUID, m_Properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
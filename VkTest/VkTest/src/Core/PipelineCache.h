@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <string>
+
+// Driver pipeline cache kept across runs. The file wraps the blob returned by
+// vkGetPipelineCacheData in a small header so that truncated or foreign files are
+// dropped before the driver ever sees them.
+// Layout: Header | blob[dataSize]
+class PipelineCache {
+public:
+    static constexpr uint32_t s_Magic = 0x43505056; // "VPPC"
+    static constexpr uint32_t s_Version = 1;
+
+    struct Header {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t dataSize;
+        uint64_t dataHash;
+    };
+public:
+    PipelineCache(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::string& filepath);
+    ~PipelineCache();
+
+    PipelineCache(const PipelineCache&) = delete;
+    PipelineCache& operator=(const PipelineCache&) = delete;
+
+    PipelineCache(PipelineCache&&) = delete;
+    PipelineCache& operator=(PipelineCache&&) = delete;
+public:
+    VkPipelineCache GetCache() const { return m_Cache; }
+    bool Save() const;
+private:
+    // Checks the VkPipelineCacheHeaderVersionOne at the front of a blob against this device
+    bool IsCompatible(const void* data, size_t size) const;
+private:
+    VkDevice                    m_Device;
+    VkPhysicalDeviceProperties  m_Properties;
+    std::string                 m_Filepath;
+    VkPipelineCache             m_Cache = VK_NULL_HANDLE;
+};
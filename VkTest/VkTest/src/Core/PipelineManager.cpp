@@ -0,0 +1,105 @@
+#include "PipelineManager.h"
+#include <Core/Device.h>
+#include <Core/ThreadPool.h>
+
+#include <stdexcept>
+
+PipelineManager::PipelineManager(Device& device)
+    : m_Device{ device } {}
+
+PipelineManager::~PipelineManager() {
+    // Workers still hold a reference to the device, let them finish before anything goes away
+    WaitIdle();
+}
+
+PipelineManager::Handle PipelineManager::RequestGraphics(
+        const std::string& vertFilePath,
+        const std::string& fragFilePath,
+        std::unique_ptr<PipelineConfigInfo> info) {
+    std::shared_ptr<PipelineConfigInfo> sharedInfo = std::move(info);
+    auto future = ThreadPool::Get().Submit([this, vertFilePath, fragFilePath, sharedInfo]() {
+        return std::make_unique<Pipeline>(m_Device, vertFilePath, fragFilePath, *sharedInfo);
+    });
+
+    return AddEntry(std::move(future));
+}
+
+PipelineManager::Handle PipelineManager::RequestCompute(const std::string& compFilePath, VkPipelineLayout pipelineLayout) {
+    auto future = ThreadPool::Get().Submit([this, compFilePath, pipelineLayout]() {
+        return std::make_unique<Pipeline>(m_Device, compFilePath, pipelineLayout);
+    });
+
+    return AddEntry(std::move(future));
+}
+
+Pipeline* PipelineManager::TryGet(Handle handle) {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+    auto it = m_Entries.find(handle);
+    if (it == m_Entries.end()) {
+        throw std::runtime_error("Unknown pipeline handle!");
+    }
+
+    auto& entry = it->second;
+    if (!entry.pipeline && entry.future.valid() &&
+        entry.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        entry.pipeline = entry.future.get();
+    }
+
+    return entry.pipeline.get();
+}
+
+bool PipelineManager::IsReady(Handle handle) {
+    return TryGet(handle) != nullptr;
+}
+
+Pipeline& PipelineManager::Get(Handle handle) {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+    auto it = m_Entries.find(handle);
+    if (it == m_Entries.end()) {
+        throw std::runtime_error("Unknown pipeline handle!");
+    }
+
+    auto& entry = it->second;
+    if (!entry.pipeline) {
+        entry.pipeline = entry.future.get();
+    }
+
+    return *entry.pipeline;
+}
+
+void PipelineManager::Release(Handle handle) {
+    std::unique_lock<std::mutex> lock{ m_Mutex };
+    auto it = m_Entries.find(handle);
+    if (it == m_Entries.end()) {
+        return;
+    }
+
+    Entry entry = std::move(it->second);
+    m_Entries.erase(it);
+    lock.unlock();
+
+    if (entry.future.valid()) {
+        // The pipeline is thrown away anyway, a compile error does not matter any more
+        try {
+            entry.future.get();
+        }
+        catch (...) {}
+    }
+}
+
+void PipelineManager::WaitIdle() {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+    for (auto& [handle, entry] : m_Entries) {
+        if (entry.future.valid()) {
+            entry.future.wait();
+        }
+    }
+}
+
+PipelineManager::Handle PipelineManager::AddEntry(std::future<std::unique_ptr<Pipeline>> future) {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+    const Handle handle = m_NextHandle++;
+    m_Entries[handle].future = std::move(future);
+
+    return handle;
+}
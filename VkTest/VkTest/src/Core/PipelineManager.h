@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Core/Pipeline.h>
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+class Device;
+
+// Compiles pipelines on the shared ThreadPool, all through the device's pipeline cache.
+// Requests return immediately with a handle; TryGet() hands out the pipeline once it is
+// built, so a frame can draw with whatever is ready instead of stalling on the slowest.
+class PipelineManager {
+public:
+    using Handle = uint32_t;
+
+    static constexpr Handle s_InvalidHandle = UINT32_MAX;
+public:
+    PipelineManager(Device& device);
+    ~PipelineManager();
+
+    PipelineManager(const PipelineManager&) = delete;
+    PipelineManager& operator=(const PipelineManager&) = delete;
+
+    PipelineManager(PipelineManager&&) = delete;
+    PipelineManager& operator=(PipelineManager&&) = delete;
+public:
+    // The config is kept alive until the worker is done with it
+    Handle RequestGraphics(
+        const std::string& vertFilePath,
+        const std::string& fragFilePath,
+        std::unique_ptr<PipelineConfigInfo> info);
+    Handle RequestCompute(const std::string& compFilePath, VkPipelineLayout pipelineLayout);
+
+    // nullptr while compiling. A failed compile rethrows its exception here.
+    Pipeline* TryGet(Handle handle);
+    bool IsReady(Handle handle);
+    // Blocks until the pipeline is built
+    Pipeline& Get(Handle handle);
+    // Waits for the compile if needed and destroys the pipeline
+    void Release(Handle handle);
+    void WaitIdle();
+private:
+    struct Entry {
+        std::future<std::unique_ptr<Pipeline>>  future;
+        std::unique_ptr<Pipeline>               pipeline;
+    };
+private:
+    Handle AddEntry(std::future<std::unique_ptr<Pipeline>> future);
+private:
+    Device&                             m_Device;
+    std::unordered_map<Handle, Entry>   m_Entries;
+    Handle                              m_NextHandle = 0;
+    std::mutex                          m_Mutex;
+};
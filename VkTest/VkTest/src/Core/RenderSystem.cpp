@@ -1,86 +1,998 @@
-#include "RenderSystem.h"
-
-#define GLM_FORCE_RADIANS
-#define GLM_FORCE_DEPTH_ZERO_TO_ONE
-#include <glm/glm.hpp>
-#include <glm/gtc/constants.hpp>
-
-#include <stdexcept>
-
-struct PushConstantData {
-    glm::mat4 transform{ 1.0f };
-    glm::mat4 normalMatrix{ 1.0f };
-};
-
-RenderSystem::RenderSystem(Device& device, VkRenderPass renderPass) 
-    : m_Device{device} {
-    CreatePipelineLayout();
-    CreatePipeline(renderPass);
-}
-
-RenderSystem::~RenderSystem() {
-    vkDestroyPipelineLayout(m_Device.GetDevice(), m_PipelineLayot, nullptr);
-}
-
-void RenderSystem::RenderGameObjects(
-    VkCommandBuffer commandBuffer, 
-    std::vector<GameObject>& gameObjects, 
-    Camera& camera
-) {
-    m_pPipeline->Bind(commandBuffer);
-
-    auto projectionView = camera.GetProjection() * camera.GetView();
-
-    for (auto& obj : gameObjects) {
-        //obj.transform.rotation.y = glm::mod(obj.transform.rotation.y + 0.0005f, glm::two_pi<float>());
-        //obj.transform.rotation.x = glm::mod(obj.transform.rotation.x + 0.0001f, glm::two_pi<float>());
-
-        PushConstantData push{};
-        auto modelMatrix = obj.transform.mat4();
-        push.transform = projectionView * modelMatrix;
-        push.normalMatrix = obj.transform.NormalMatrix();
-
-        vkCmdPushConstants(
-            commandBuffer,
-            m_PipelineLayot,
-            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-            0,
-            sizeof(PushConstantData),
-            &push
-        );
-
-        obj.model->Bind(commandBuffer);
-        obj.model->Draw(commandBuffer);
-    }
-}
-
-void RenderSystem::CreatePipeline(VkRenderPass renderPass) {
-    PipelineConfigInfo pipelineConfig;
-    Pipeline::DefaultPipelineConfigInfo(pipelineConfig);
-
-    pipelineConfig.renderPass = renderPass;
-    pipelineConfig.pipelineLayout = m_PipelineLayot;
-    m_pPipeline = std::make_unique<Pipeline>(
-        m_Device,
-        "C:/dev/VkTest/VkTest/src/Shaders/spv.vert",
-        "C:/dev/VkTest/VkTest/src/Shaders/spv.frag",
-        pipelineConfig);
-}
-
-void RenderSystem::CreatePipelineLayout() {
-    VkPushConstantRange pushConstantRange{};
-    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
-    pushConstantRange.offset = 0;
-    pushConstantRange.size = sizeof(PushConstantData);
-
-    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.setLayoutCount = 0;
-    pipelineLayoutInfo.pSetLayouts = nullptr;
-    pipelineLayoutInfo.pushConstantRangeCount = 1;
-    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
-
-    if (vkCreatePipelineLayout(m_Device.GetDevice(), &pipelineLayoutInfo, nullptr, &m_PipelineLayot) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create pipeline layout");
-    }
+#include "RenderSystem.h"
+#include <Core/FrameContext.h>
+#include <Core/Frustum.h>
+#include <Core/GpuProfiler.h>
+#include <Core/PipelineManager.h>
+#include <Core/ThreadPool.h>
+#include <Core/Trace.h>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+
+struct PushConstantData {
+    glm::mat4 transform{ 1.0f };
+    glm::mat4 normalMatrix{ 1.0f };
+};
+
+struct InstanceData {
+    glm::mat4 transform{ 1.0f };
+    glm::mat4 normalMatrix{ 1.0f };
+};
+
+// Mirrors the std430 structs in cull.comp and indirect.vert
+struct GpuObjectData {
+    glm::mat4 transform{ 1.0f };
+    glm::mat4 normalMatrix{ 1.0f };
+    uint32_t  meshIndex = 0;
+    uint32_t  drawBase = 0;     // first draw slot of the object's batch
+    uint32_t  batch = 0;        // which draw counter the compacting cull bumps
+    uint32_t  padding = 0;
+};
+
+struct GpuMeshData {
+    glm::vec4 boundingSphere{ 0.0f };
+    uint32_t  indexCount = 0;
+    uint32_t  firstIndex = 0;
+    int32_t   vertexOffset = 0;
+    uint32_t  padding = 0;
+};
+
+struct CullPushConstantData {
+    glm::vec4 frustumPlanes[6];
+    uint32_t  objectCount = 0;
+    uint32_t  compact = 0;
+};
+
+static constexpr uint32_t s_MinInstanceCapacity = 1024;
+static constexpr uint32_t s_CullGroupSize = 64;
+// Below this many draws a worker costs more to wake up than it saves
+static constexpr size_t s_MinDrawsPerRecorder = 256;
+
+// Vertex shaders per Model::VertexFormat, the packed ones are built with -DPACKED_VERTEX
+static const char* const s_DirectVertexShaders[Model::s_VertexFormatCount]{
+    "C:/dev/VkTest/VkTest/src/Shaders/spv.vert",
+    "C:/dev/VkTest/VkTest/src/Shaders/spv_packed.vert"
+};
+static const char* const s_InstancedVertexShaders[Model::s_VertexFormatCount]{
+    "C:/dev/VkTest/VkTest/src/Shaders/spv_instanced.vert",
+    "C:/dev/VkTest/VkTest/src/Shaders/spv_packed_instanced.vert"
+};
+static const char* const s_IndirectVertexShaders[Model::s_VertexFormatCount]{
+    "C:/dev/VkTest/VkTest/src/Shaders/spv_indirect.vert",
+    "C:/dev/VkTest/VkTest/src/Shaders/spv_packed_indirect.vert"
+};
+
+static void SetVertexInput(PipelineConfigInfo& configInfo, Model::VertexFormat format) {
+    if (format == Model::VertexFormat::Packed) {
+        configInfo.bindingDescriptions = Model::PackedVertex::GetBindingDescriptions();
+        configInfo.attributeDescriptions = Model::PackedVertex::GetAttribDescriptions();
+    }
+    else {
+        configInfo.bindingDescriptions = Model::Vertex::GetBindingDescriptions();
+        configInfo.attributeDescriptions = Model::Vertex::GetAttribDescriptions();
+    }
+}
+
+// Draws with equal keys read the same vertex and index buffers with the same index type
+using GeometryBinding = std::tuple<const GeometryPool*, uint32_t, VkIndexType>;
+
+static GeometryBinding GeometryKey(const Model* model) {
+    return { &model->GetGeometryPool(), model->GetGeometry().page, model->GetGeometry().indexType };
+}
+
+// A level with triangle ratio r is used once the projected radius of the world space sphere
+// drops below lodScreenSize * sqrt(r), which keeps triangles per unit of screen area about even
+static uint32_t SelectLod(
+        const Model& model,
+        const glm::mat4& projectionView,
+        float projectionScale,
+        float lodScreenSize,
+        const glm::vec3& center,
+        float radius) {
+    if (model.GetLodCount() == 1 || lodScreenSize <= 0.0f) {
+        return 0;
+    }
+
+    // w is the view depth for perspective projections and 1 for orthographic ones, the
+    // projection's y scale then turns radius over w into a fraction of half the viewport
+    const float w = (projectionView * glm::vec4{ center, 1.0f }).w;
+    const float screenSize = radius * projectionScale / std::max(w, 1e-6f);
+
+    for (uint32_t lod = model.GetLodCount() - 1; lod > 0; lod--) {
+        if (screenSize < lodScreenSize * std::sqrt(model.GetLod(lod).triangleRatio)) {
+            return lod;
+        }
+    }
+    return 0;
+}
+
+// Indirect batches need one pipeline and one index type each
+static uint32_t IndirectBindingClass(const Model* model) {
+    const uint32_t indexClass = model->GetGeometry().indexType == VK_INDEX_TYPE_UINT16 ? 1 : 0;
+    return static_cast<uint32_t>(model->GetVertexFormat()) * 2 + indexClass;
+}
+
+RenderSystem::RenderSystem(Device& device, VkRenderPass renderPass) 
+    : m_Device{device}, m_RenderPass{ renderPass } {
+    CreatePipelineLayout();
+
+    m_IndirectSupported = m_Device.GetEnabledFeatures().drawIndirectFirstInstance == VK_TRUE;
+    if (m_IndirectSupported) {
+        CreateIndirectResources();
+    }
+
+    RequestPipelines(Model::VertexFormat::Full);
+}
+
+RenderSystem::~RenderSystem() {
+    // Waits for compiles still using the layouts destroyed below
+    auto& pipelines = m_Device.GetPipelineManager();
+    for (uint32_t format = 0; format < Model::s_VertexFormatCount; format++) {
+        pipelines.Release(m_Pipelines[format]);
+        pipelines.Release(m_InstancedPipelines[format]);
+        pipelines.Release(m_IndirectPipelines[format]);
+    }
+    pipelines.Release(m_CullPipeline);
+
+    for (auto& instanceBuffer : m_InstanceBuffers) {
+        DestroyBuffer(instanceBuffer);
+    }
+
+    for (auto& frame : m_IndirectFrames) {
+        DestroyBuffer(frame.objects);
+        DestroyBuffer(frame.meshes);
+        DestroyBuffer(frame.draws);
+        DestroyBuffer(frame.drawCounts);
+    }
+
+    if (m_IndirectSupported) {
+        vkDestroyDescriptorPool(m_Device.GetDevice(), m_IndirectDescriptorPool, nullptr);
+        vkDestroyPipelineLayout(m_Device.GetDevice(), m_CullPipelineLayout, nullptr);
+        vkDestroyPipelineLayout(m_Device.GetDevice(), m_IndirectPipelineLayout, nullptr);
+        vkDestroyDescriptorSetLayout(m_Device.GetDevice(), m_IndirectSetLayout, nullptr);
+    }
+    vkDestroyPipelineLayout(m_Device.GetDevice(), m_PipelineLayot, nullptr);
+}
+
+void RenderSystem::SetRenderMode(RenderMode mode) {
+    if (mode == RenderMode::Indirect && !m_IndirectSupported) {
+        mode = RenderMode::Instanced;
+    }
+    m_RenderMode = mode;
+}
+
+void RenderSystem::PrepareGameObjects(FrameInfo& frameInfo, Scene& scene) {
+    TRACE_ZONE("RenderSystem::PrepareGameObjects");
+    m_FrameRenderMode = ResolveRenderMode();
+    m_FramePipelines = {};
+    if (m_FrameRenderMode == RenderMode::Direct || m_FrameRenderMode == RenderMode::Parallel) {
+        m_FramePipelines = GetPipelines(m_Pipelines);
+    }
+    else if (m_FrameRenderMode == RenderMode::Instanced) {
+        m_FramePipelines = GetPipelines(m_InstancedPipelines);
+    }
+    else if (m_FrameRenderMode == RenderMode::Indirect) {
+        m_FramePipelines = GetPipelines(m_IndirectPipelines);
+    }
+
+    if (m_FrameRenderMode == RenderMode::Indirect) {
+        CullIndirect(frameInfo, scene);
+    }
+}
+
+void RenderSystem::RenderGameObjects(FrameInfo& frameInfo, Scene& scene) {
+    TRACE_ZONE("RenderSystem::RenderGameObjects");
+    // Nothing has finished compiling yet
+    if (!m_FrameRenderMode) {
+        return;
+    }
+
+    switch (*m_FrameRenderMode) {
+    case RenderMode::Direct:
+        RenderDirect(frameInfo, scene);
+        break;
+    case RenderMode::Instanced:
+        RenderInstanced(frameInfo, scene);
+        break;
+    case RenderMode::Indirect:
+        RenderIndirect(frameInfo);
+        break;
+    case RenderMode::Parallel:
+        RenderParallel(frameInfo, scene);
+        break;
+    }
+}
+
+VkSubpassContents RenderSystem::GetSubpassContents() const {
+    return m_FrameRenderMode == RenderMode::Parallel ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS : VK_SUBPASS_CONTENTS_INLINE;
+}
+
+// Only the Full pipelines decide the mode, models of other formats wait for theirs in CanDraw
+std::optional<RenderSystem::RenderMode> RenderSystem::ResolveRenderMode() {
+    constexpr Model::VertexFormat full = Model::VertexFormat::Full;
+    if (m_RenderMode == RenderMode::Indirect && m_Device.GetPipelineManager().IsReady(m_CullPipeline) && IsReady(m_IndirectPipelines, full)) {
+        return RenderMode::Indirect;
+    }
+    if (m_RenderMode == RenderMode::Parallel && IsReady(m_Pipelines, full)) {
+        return RenderMode::Parallel;
+    }
+    if (m_RenderMode != RenderMode::Direct && IsReady(m_InstancedPipelines, full)) {
+        return RenderMode::Instanced;
+    }
+    if (IsReady(m_Pipelines, full)) {
+        return RenderMode::Direct;
+    }
+
+    return std::nullopt;
+}
+
+bool RenderSystem::IsReady(const FormatPipelines& handles, Model::VertexFormat format) {
+    const PipelineManager::Handle handle = handles[static_cast<uint32_t>(format)];
+    return handle != PipelineManager::s_InvalidHandle && m_Device.GetPipelineManager().IsReady(handle);
+}
+
+RenderSystem::FormatPipelineRefs RenderSystem::GetPipelines(const FormatPipelines& handles) {
+    FormatPipelineRefs refs{};
+    for (uint32_t format = 0; format < Model::s_VertexFormatCount; format++) {
+        if (handles[format] != PipelineManager::s_InvalidHandle) {
+            refs[format] = m_Device.GetPipelineManager().TryGet(handles[format]);
+        }
+    }
+    return refs;
+}
+
+bool RenderSystem::CanDraw(Model::VertexFormat format) {
+    if (m_Pipelines[static_cast<uint32_t>(format)] == PipelineManager::s_InvalidHandle) {
+        RequestPipelines(format);
+    }
+    return m_FramePipelines[static_cast<uint32_t>(format)] != nullptr;
+}
+
+void RenderSystem::CullGameObjects(FrameInfo& frameInfo, Scene& scene) {
+    TRACE_ZONE("RenderSystem::CullGameObjects");
+    m_CullModels.clear();
+    m_CullSources.clear();
+    m_CullSphereX.clear();
+    m_CullSphereY.clear();
+    m_CullSphereZ.clear();
+    m_CullSphereRadius.clear();
+
+    scene.Each<MeshComponent, WorldTransformComponent>([&](Entity entity, MeshComponent& mesh, WorldTransformComponent& transform) {
+        Model* model = mesh.model.get();
+        // Still streaming in on the transfer queue, or its format's pipeline is still compiling
+        if (!model || !model->IsReady() || !CanDraw(model->GetVertexFormat())) {
+            return;
+        }
+
+        const glm::vec4& sphere = model->GetBoundingSphere();
+        const glm::vec4 center = transform.world * glm::vec4{ glm::vec3{ sphere }, 1.0f };
+        const float radius = sphere.w * transform.maxScale;
+
+        if (auto* bounds = scene.TryGet<BoundsComponent>(entity)) {
+            bounds->sphere = glm::vec4{ glm::vec3{ center }, radius };
+        }
+
+        m_CullModels.push_back(model);
+        m_CullSources.push_back(&transform);
+        m_CullSphereX.push_back(center.x);
+        m_CullSphereY.push_back(center.y);
+        m_CullSphereZ.push_back(center.z);
+        m_CullSphereRadius.push_back(radius);
+    });
+
+    const size_t count = m_CullModels.size();
+    m_CullVisible.resize(count);
+
+    const Frustum frustum{ frameInfo.camera.GetProjection() * frameInfo.camera.GetView() };
+    frustum.CullSpheres(
+        m_CullSphereX.data(),
+        m_CullSphereY.data(),
+        m_CullSphereZ.data(),
+        m_CullSphereRadius.data(),
+        count,
+        m_CullVisible.data());
+
+    m_VisibleObjects.clear();
+    for (uint32_t slot = 0; slot < count; slot++) {
+        if (m_CullVisible[slot]) {
+            m_VisibleObjects.push_back(slot);
+        }
+    }
+
+    const glm::mat4 projectionView = frameInfo.camera.GetProjection() * frameInfo.camera.GetView();
+    const float projectionScale = std::abs(frameInfo.camera.GetProjection()[1][1]);
+    m_CullLods.resize(count);
+    for (uint32_t slot : m_VisibleObjects) {
+        const glm::vec3 center{ m_CullSphereX[slot], m_CullSphereY[slot], m_CullSphereZ[slot] };
+        m_CullLods[slot] = SelectLod(
+            *m_CullModels[slot],
+            projectionView,
+            projectionScale,
+            m_LodScreenSize,
+            center,
+            m_CullSphereRadius[slot]);
+    }
+
+    // Grouped by geometry page so recording only rebinds buffers when the page changes.
+    // Almost always a single page, which the is_sorted check gets through in one pass.
+    auto byGeometry = [this](uint32_t a, uint32_t b) { return GeometryKey(m_CullModels[a]) < GeometryKey(m_CullModels[b]); };
+    if (!std::is_sorted(m_VisibleObjects.begin(), m_VisibleObjects.end(), byGeometry)) {
+        std::stable_sort(m_VisibleObjects.begin(), m_VisibleObjects.end(), byGeometry);
+    }
+
+    frameInfo.stats.objectCount += static_cast<uint32_t>(count);
+    frameInfo.stats.culledCount += static_cast<uint32_t>(count - m_VisibleObjects.size());
+}
+
+void RenderSystem::RenderDirect(FrameInfo& frameInfo, Scene& scene) {
+    CullGameObjects(frameInfo, scene);
+
+    auto commandBuffer = frameInfo.commandBuffer;
+    auto projectionView = frameInfo.camera.GetProjection() * frameInfo.camera.GetView();
+    RecordDirect(commandBuffer, m_FramePipelines, projectionView, 0, m_VisibleObjects.size(), frameInfo.stats);
+}
+
+void RenderSystem::RenderParallel(FrameInfo& frameInfo, Scene& scene) {
+    CullGameObjects(frameInfo, scene);
+
+    const size_t drawCount = m_VisibleObjects.size();
+    if (drawCount == 0) {
+        return;
+    }
+
+    // Recorder slot 0 is the main thread's, chunk i is always recorded from slot i + 1
+    auto& frameContext = *frameInfo.frameContext;
+    const size_t workerSlots = frameContext.GetRecorderCount() - 1;
+    const size_t grainSize = std::max(s_MinDrawsPerRecorder, (drawCount + workerSlots - 1) / workerSlots);
+    const size_t chunkCount = (drawCount + grainSize - 1) / grainSize;
+
+    m_SecondaryBuffers.resize(chunkCount);
+    m_RecorderStats.assign(chunkCount, FrameStats{});
+    for (size_t i = 0; i < chunkCount; i++) {
+        m_SecondaryBuffers[i] = frameContext.AllocateCommandBuffer(VK_COMMAND_BUFFER_LEVEL_SECONDARY, static_cast<uint32_t>(i + 1));
+    }
+
+    const FormatPipelineRefs& pipelines = m_FramePipelines;
+    const glm::mat4 projectionView = frameInfo.camera.GetProjection() * frameInfo.camera.GetView();
+    ThreadPool::Get().ParallelFor(drawCount, grainSize, [&](size_t begin, size_t end) {
+        const size_t chunk = begin / grainSize;
+        VkCommandBuffer commandBuffer = m_SecondaryBuffers[chunk];
+
+        VkCommandBufferInheritanceInfo inheritanceInfo{};
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.renderPass = m_RenderPass;
+        inheritanceInfo.subpass = 0;
+        // Has to match a GpuProfiler statistics query that may be active around the render pass
+        if (m_Device.GetEnabledFeatures().pipelineStatisticsQuery && m_Device.GetEnabledFeatures().inheritedQueries) {
+            inheritanceInfo.pipelineStatistics = GpuProfiler::s_StatisticFlags;
+        }
+
+        VkCommandBufferBeginInfo beginInfo{};
+        beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+        beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+        if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to begin recording command buffer!");
+        }
+
+        VkViewport viewport{};
+        viewport.width = static_cast<float>(frameInfo.extent.width);
+        viewport.height = static_cast<float>(frameInfo.extent.height);
+        viewport.minDepth = 0.0f;
+        viewport.maxDepth = 1.0f;
+        VkRect2D scissor{ {0, 0}, frameInfo.extent };
+        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+        // Every secondary starts without a bound pipeline or buffers
+        RecordDirect(commandBuffer, pipelines, projectionView, begin, end, m_RecorderStats[chunk]);
+
+        if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to record command buffer!");
+        }
+    });
+
+    vkCmdExecuteCommands(frameInfo.commandBuffer, static_cast<uint32_t>(chunkCount), m_SecondaryBuffers.data());
+    for (const auto& stats : m_RecorderStats) {
+        frameInfo.stats.drawCount += stats.drawCount;
+        frameInfo.stats.geometryBindCount += stats.geometryBindCount;
+    }
+}
+
+void RenderSystem::RecordDirect(
+        VkCommandBuffer commandBuffer,
+        const FormatPipelineRefs& pipelines,
+        const glm::mat4& projectionView,
+        size_t begin,
+        size_t end,
+        FrameStats& stats) {
+    GeometryBinding boundGeometry{ nullptr, 0, VK_INDEX_TYPE_UINT32 };
+    const Pipeline* boundPipeline = nullptr;
+
+    for (size_t i = begin; i < end; i++) {
+        const uint32_t slot = m_VisibleObjects[i];
+        Model* model = m_CullModels[slot];
+
+        PushConstantData push{};
+        push.transform = projectionView * model->GetDrawMatrix(m_CullSources[slot]->world);
+        push.normalMatrix = m_CullSources[slot]->normal;
+
+        // Pipelines share the layout, so the push constants survive a pipeline switch
+        Pipeline* pipeline = pipelines[static_cast<uint32_t>(model->GetVertexFormat())];
+        if (pipeline != boundPipeline) {
+            pipeline->Bind(commandBuffer);
+            boundPipeline = pipeline;
+        }
+
+        vkCmdPushConstants(
+            commandBuffer,
+            m_PipelineLayot,
+            VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+            0,
+            sizeof(PushConstantData),
+            &push
+        );
+
+        if (GeometryKey(model) != boundGeometry) {
+            model->Bind(commandBuffer);
+            boundGeometry = GeometryKey(model);
+            stats.geometryBindCount++;
+        }
+        const uint32_t lod = m_CullLods[slot];
+        model->Draw(commandBuffer, 1, 0, lod);
+        stats.drawCount += static_cast<uint32_t>(model->GetSubmeshes(lod).size());
+    }
+}
+
+void RenderSystem::RenderInstanced(FrameInfo& frameInfo, Scene& scene) {
+    CullGameObjects(frameInfo, scene);
+
+    // Sorting by model and level turns every run of equal pairs into one instanced draw. The
+    // geometry page goes first so that models sharing buffers are drawn back to back.
+    m_DrawOrder.clear();
+    for (uint32_t slot : m_VisibleObjects) {
+        m_DrawOrder.emplace_back(m_CullModels[slot], slot);
+    }
+
+    if (m_DrawOrder.empty()) {
+        return;
+    }
+
+    std::sort(m_DrawOrder.begin(), m_DrawOrder.end(), [this](const auto& a, const auto& b) {
+        const auto keyA = GeometryKey(a.first);
+        const auto keyB = GeometryKey(b.first);
+        if (keyA != keyB) {
+            return keyA < keyB;
+        }
+        if (a.first != b.first) {
+            return a.first < b.first;
+        }
+        const uint32_t lodA = m_CullLods[a.second];
+        const uint32_t lodB = m_CullLods[b.second];
+        return lodA != lodB ? lodA < lodB : a.second < b.second;
+    });
+
+    auto& instanceBuffer = m_InstanceBuffers[frameInfo.frameIndex];
+    ReserveBuffer(
+        instanceBuffer,
+        sizeof(InstanceData) * std::max<size_t>(m_DrawOrder.size(), s_MinInstanceCapacity),
+        VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+    auto* instances = static_cast<InstanceData*>(instanceBuffer.memory.mappedData);
+    for (size_t i = 0; i < m_DrawOrder.size(); i++) {
+        const uint32_t slot = m_DrawOrder[i].second;
+        instances[i].transform = m_DrawOrder[i].first->GetDrawMatrix(m_CullSources[slot]->world);
+        instances[i].normalMatrix = m_CullSources[slot]->normal;
+    }
+
+    auto commandBuffer = frameInfo.commandBuffer;
+    const FormatPipelineRefs& pipelines = m_FramePipelines;
+    const Pipeline* boundPipeline = nullptr;
+
+    PushConstantData push{};
+    push.transform = frameInfo.camera.GetProjection() * frameInfo.camera.GetView();
+    vkCmdPushConstants(
+        commandBuffer,
+        m_PipelineLayot,
+        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+        0,
+        sizeof(PushConstantData),
+        &push
+    );
+
+    VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 1, 1, &instanceBuffer.buffer, &offset);
+
+    GeometryBinding boundGeometry{ nullptr, 0, VK_INDEX_TYPE_UINT32 };
+    uint32_t first = 0;
+    while (first < m_DrawOrder.size()) {
+        Model* model = m_DrawOrder[first].first;
+        const uint32_t lod = m_CullLods[m_DrawOrder[first].second];
+
+        uint32_t last = first + 1;
+        while (last < m_DrawOrder.size() && m_DrawOrder[last].first == model && m_CullLods[m_DrawOrder[last].second] == lod) {
+            last++;
+        }
+
+        Pipeline* pipeline = pipelines[static_cast<uint32_t>(model->GetVertexFormat())];
+        if (pipeline != boundPipeline) {
+            pipeline->Bind(commandBuffer);
+            boundPipeline = pipeline;
+        }
+        if (GeometryKey(model) != boundGeometry) {
+            model->Bind(commandBuffer);
+            boundGeometry = GeometryKey(model);
+            frameInfo.stats.geometryBindCount++;
+        }
+        model->Draw(commandBuffer, last - first, first, lod);
+        frameInfo.stats.drawCount += static_cast<uint32_t>(model->GetSubmeshes(lod).size());
+
+        first = last;
+    }
+}
+
+void RenderSystem::CullIndirect(FrameInfo& frameInfo, Scene& scene) {
+    auto& frame = m_IndirectFrames[frameInfo.frameIndex];
+    const VkMemoryPropertyFlags hostVisible = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+    // Meshes hold every submesh of every level of a model in turn. The level is picked here,
+    // the GPU only culls, and each submesh of a split model is an object of its own.
+    const glm::mat4 projectionView = frameInfo.camera.GetProjection() * frameInfo.camera.GetView();
+    const float projectionScale = std::abs(frameInfo.camera.GetProjection()[1][1]);
+
+    m_MeshIndices.clear();
+    m_IndirectObjects.clear();
+    uint32_t meshCount = 0;
+    uint32_t sceneObjectCount = 0;
+    scene.Each<MeshComponent, WorldTransformComponent>([&](Entity entity, MeshComponent& meshComponent, WorldTransformComponent& transform) {
+        Model* model = meshComponent.model.get();
+        if (!model || !model->IsReady() || !CanDraw(model->GetVertexFormat())) {
+            return;
+        }
+
+        auto [it, inserted] = m_MeshIndices.try_emplace(model, meshCount);
+        if (inserted) {
+            for (uint32_t lod = 0; lod < model->GetLodCount(); lod++) {
+                meshCount += static_cast<uint32_t>(model->GetSubmeshes(lod).size());
+            }
+        }
+
+        const glm::vec4& sphere = model->GetBoundingSphere();
+        const glm::vec4 center = transform.world * glm::vec4{ glm::vec3{ sphere }, 1.0f };
+        const uint32_t lod = SelectLod(*model, projectionView, projectionScale, m_LodScreenSize, glm::vec3{ center }, sphere.w * transform.maxScale);
+
+        uint32_t firstMesh = it->second;
+        for (uint32_t finer = 0; finer < lod; finer++) {
+            firstMesh += static_cast<uint32_t>(model->GetSubmeshes(finer).size());
+        }
+
+        const uint32_t submeshCount = static_cast<uint32_t>(model->GetSubmeshes(lod).size());
+        for (uint32_t submesh = 0; submesh < submeshCount; submesh++) {
+            m_IndirectObjects.push_back({ &transform, model, firstMesh + submesh, 0 });
+        }
+        sceneObjectCount++;
+    });
+
+    const size_t capacity = std::max<size_t>(std::max<size_t>(m_IndirectObjects.size(), meshCount), s_MinInstanceCapacity);
+    ReserveBuffer(frame.objects, sizeof(GpuObjectData) * capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostVisible);
+    ReserveBuffer(frame.meshes, sizeof(GpuMeshData) * capacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, hostVisible);
+    ReserveBuffer(
+        frame.draws,
+        sizeof(VkDrawIndexedIndirectCommand) * capacity,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    auto* objects = static_cast<GpuObjectData*>(frame.objects.memory.mappedData);
+    auto* meshes = static_cast<GpuMeshData*>(frame.meshes.memory.mappedData);
+
+    for (const auto& [model, firstMesh] : m_MeshIndices) {
+        uint32_t meshIndex = firstMesh;
+        for (uint32_t lod = 0; lod < model->GetLodCount(); lod++) {
+            for (const auto& submesh : model->GetSubmeshes(lod)) {
+                auto& mesh = meshes[meshIndex++];
+                // Tested against the draw matrix, so it has to be in stored vertex space
+                mesh.boundingSphere = model->GetDrawBoundingSphere();
+                mesh.indexCount = submesh.indexCount;
+                mesh.firstIndex = submesh.firstIndex;
+                mesh.vertexOffset = submesh.vertexOffset;
+            }
+        }
+    }
+
+    // Counting sort by (vertex format, index type, geometry page), so that everything drawn
+    // with the same pipeline and buffers is one contiguous batch. Group ids number each
+    // binding class's pages in turn.
+    std::array<uint32_t, Model::s_VertexFormatCount * 2> groupBase{};
+    for (const auto& source : m_IndirectObjects) {
+        auto& pageCount = groupBase[IndirectBindingClass(source.model)];
+        pageCount = std::max(pageCount, source.model->GetGeometry().page + 1);
+    }
+
+    uint32_t groupCount = 0;
+    for (auto& base : groupBase) {
+        const uint32_t pageCount = base;
+        base = groupCount;
+        groupCount += pageCount;
+    }
+
+    m_GroupCursors.assign(groupCount, 0);
+    m_GroupBatches.assign(groupCount, 0);
+    m_GroupModels.assign(groupCount, nullptr);
+    for (auto& source : m_IndirectObjects) {
+        source.group = groupBase[IndirectBindingClass(source.model)] + source.model->GetGeometry().page;
+        m_GroupCursors[source.group]++;
+        m_GroupModels[source.group] = source.model;
+    }
+
+    frame.batches.clear();
+    uint32_t objectCount = 0;
+    for (uint32_t group = 0; group < groupCount; group++) {
+        const uint32_t groupObjects = m_GroupCursors[group];
+        if (groupObjects == 0) {
+            continue;
+        }
+
+        const Model* model = m_GroupModels[group];
+        m_GroupBatches[group] = static_cast<uint32_t>(frame.batches.size());
+        frame.batches.push_back({
+            &model->GetGeometryPool(),
+            model->GetGeometry().page,
+            model->GetGeometry().indexType,
+            model->GetVertexFormat(),
+            objectCount,
+            groupObjects });
+        m_GroupCursors[group] = objectCount;
+        objectCount += groupObjects;
+    }
+
+    for (const auto& source : m_IndirectObjects) {
+        const uint32_t batch = m_GroupBatches[source.group];
+        auto& object = objects[m_GroupCursors[source.group]++];
+        object.transform = source.model->GetDrawMatrix(source.transform->world);
+        object.normalMatrix = source.transform->normal;
+        object.meshIndex = source.meshIndex;
+        object.drawBase = frame.batches[batch].firstObject;
+        object.batch = batch;
+    }
+    frame.objectCount = objectCount;
+
+    ReserveBuffer(
+        frame.drawCounts,
+        sizeof(uint32_t) * std::max<size_t>(frame.batches.size(), 1),
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+    // Culling happens on the GPU, the survivors are never read back
+    frameInfo.stats.objectCount += sceneObjectCount;
+
+    // The previous use of this frame slot has retired, so its set can be rewritten in place
+    VkDescriptorBufferInfo bufferInfos[4]{
+        { frame.objects.buffer, 0, VK_WHOLE_SIZE },
+        { frame.meshes.buffer, 0, VK_WHOLE_SIZE },
+        { frame.draws.buffer, 0, VK_WHOLE_SIZE },
+        { frame.drawCounts.buffer, 0, VK_WHOLE_SIZE }
+    };
+
+    VkWriteDescriptorSet writes[4]{};
+    for (uint32_t i = 0; i < 4; i++) {
+        writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        writes[i].dstSet = frame.descriptorSet;
+        writes[i].dstBinding = i;
+        writes[i].descriptorCount = 1;
+        writes[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        writes[i].pBufferInfo = &bufferInfos[i];
+    }
+    vkUpdateDescriptorSets(m_Device.GetDevice(), 4, writes, 0, nullptr);
+
+    if (objectCount == 0) {
+        return;
+    }
+
+    auto commandBuffer = frameInfo.commandBuffer;
+    vkCmdFillBuffer(commandBuffer, frame.drawCounts.buffer, 0, sizeof(uint32_t) * frame.batches.size(), 0);
+
+    VkMemoryBarrier clearBarrier{};
+    clearBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    clearBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    clearBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        1, &clearBarrier,
+        0, nullptr,
+        0, nullptr);
+
+    const Frustum frustum{ frameInfo.camera.GetProjection() * frameInfo.camera.GetView() };
+    CullPushConstantData push{};
+    std::copy(frustum.GetPlanes(), frustum.GetPlanes() + 6, push.frustumPlanes);
+    push.objectCount = objectCount;
+    push.compact = m_pfnDrawIndexedIndirectCount != nullptr ? 1 : 0;
+
+    m_Device.GetPipelineManager().Get(m_CullPipeline).Bind(commandBuffer);
+    vkCmdBindDescriptorSets(
+        commandBuffer,
+        VK_PIPELINE_BIND_POINT_COMPUTE,
+        m_CullPipelineLayout,
+        0,
+        1, &frame.descriptorSet,
+        0, nullptr);
+    vkCmdPushConstants(commandBuffer, m_CullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(CullPushConstantData), &push);
+    vkCmdDispatch(commandBuffer, (objectCount + s_CullGroupSize - 1) / s_CullGroupSize, 1, 1);
+
+    VkMemoryBarrier cullBarrier{};
+    cullBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+    cullBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    cullBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    vkCmdPipelineBarrier(
+        commandBuffer,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+        0,
+        1, &cullBarrier,
+        0, nullptr,
+        0, nullptr);
+}
+
+void RenderSystem::RenderIndirect(FrameInfo& frameInfo) {
+    auto& frame = m_IndirectFrames[frameInfo.frameIndex];
+    if (frame.objectCount == 0) {
+        return;
+    }
+
+    auto commandBuffer = frameInfo.commandBuffer;
+    vkCmdBindDescriptorSets(
+        commandBuffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS,
+        m_IndirectPipelineLayout,
+        0,
+        1, &frame.descriptorSet,
+        0, nullptr);
+
+    PushConstantData push{};
+    push.transform = frameInfo.camera.GetProjection() * frameInfo.camera.GetView();
+    vkCmdPushConstants(
+        commandBuffer,
+        m_IndirectPipelineLayout,
+        VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+        0,
+        sizeof(PushConstantData),
+        &push
+    );
+
+    // Batches come ordered by format, so each pipeline is bound once
+    const FormatPipelineRefs& pipelines = m_FramePipelines;
+    const Pipeline* boundPipeline = nullptr;
+
+    const uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+    for (uint32_t batchIndex = 0; batchIndex < frame.batches.size(); batchIndex++) {
+        const auto& batch = frame.batches[batchIndex];
+        const VkDeviceSize drawOffset = static_cast<VkDeviceSize>(batch.firstObject) * stride;
+
+        Pipeline* pipeline = pipelines[static_cast<uint32_t>(batch.format)];
+        if (pipeline != boundPipeline) {
+            pipeline->Bind(commandBuffer);
+            boundPipeline = pipeline;
+        }
+        batch.pool->Bind(commandBuffer, batch.page, batch.indexType);
+        frameInfo.stats.geometryBindCount++;
+
+        if (m_pfnDrawIndexedIndirectCount) {
+            m_pfnDrawIndexedIndirectCount(
+                commandBuffer,
+                frame.draws.buffer, drawOffset,
+                frame.drawCounts.buffer, sizeof(uint32_t) * batchIndex,
+                batch.objectCount,
+                stride);
+            frameInfo.stats.drawCount++;
+        }
+        else if (m_Device.GetEnabledFeatures().multiDrawIndirect) {
+            // Culled slots were written with instanceCount = 0
+            vkCmdDrawIndexedIndirect(commandBuffer, frame.draws.buffer, drawOffset, batch.objectCount, stride);
+            frameInfo.stats.drawCount++;
+        }
+        else {
+            for (uint32_t i = 0; i < batch.objectCount; i++) {
+                vkCmdDrawIndexedIndirect(commandBuffer, frame.draws.buffer, drawOffset + static_cast<VkDeviceSize>(i) * stride, 1, stride);
+            }
+            frameInfo.stats.drawCount += batch.objectCount;
+        }
+    }
+}
+
+void RenderSystem::ReserveBuffer(
+        FrameBuffer& frameBuffer,
+        VkDeviceSize size,
+        VkBufferUsageFlags usage,
+        VkMemoryPropertyFlags properties) {
+    if (size <= frameBuffer.size) {
+        return;
+    }
+
+    // The fence for this frame slot has already been waited on, nothing reads the old buffer
+    DestroyBuffer(frameBuffer);
+
+    VkDeviceSize capacity = std::max<VkDeviceSize>(frameBuffer.size, 1);
+    while (capacity < size) {
+        capacity *= 2;
+    }
+
+    m_Device.CreateBuffer(capacity, usage, properties, frameBuffer.buffer, frameBuffer.memory);
+    frameBuffer.size = capacity;
+}
+
+void RenderSystem::DestroyBuffer(FrameBuffer& frameBuffer) {
+    if (frameBuffer.buffer != VK_NULL_HANDLE) {
+        m_Device.DestroyBuffer(frameBuffer.buffer, frameBuffer.memory);
+        frameBuffer.buffer = VK_NULL_HANDLE;
+        frameBuffer.size = 0;
+    }
+}
+
+void RenderSystem::RequestPipelines(Model::VertexFormat format) {
+    auto& pipelines = m_Device.GetPipelineManager();
+    const uint32_t index = static_cast<uint32_t>(format);
+
+    auto pipelineConfig = std::make_unique<PipelineConfigInfo>();
+    Pipeline::DefaultPipelineConfigInfo(*pipelineConfig);
+    SetVertexInput(*pipelineConfig, format);
+
+    pipelineConfig->renderPass = m_RenderPass;
+    pipelineConfig->pipelineLayout = m_PipelineLayot;
+    m_Pipelines[index] = pipelines.RequestGraphics(
+        s_DirectVertexShaders[index],
+        "C:/dev/VkTest/VkTest/src/Shaders/spv.frag",
+        std::move(pipelineConfig));
+
+    auto instancedConfig = std::make_unique<PipelineConfigInfo>();
+    Pipeline::DefaultPipelineConfigInfo(*instancedConfig);
+    SetVertexInput(*instancedConfig, format);
+
+    instancedConfig->bindingDescriptions.push_back({ 1, sizeof(InstanceData), VK_VERTEX_INPUT_RATE_INSTANCE });
+    for (uint32_t column = 0; column < 4; column++) {
+        instancedConfig->attributeDescriptions.push_back(
+            { 4 + column, 1, VK_FORMAT_R32G32B32A32_SFLOAT, static_cast<uint32_t>(offsetof(InstanceData, transform) + column * sizeof(glm::vec4)) });
+    }
+    for (uint32_t column = 0; column < 4; column++) {
+        instancedConfig->attributeDescriptions.push_back(
+            { 8 + column, 1, VK_FORMAT_R32G32B32A32_SFLOAT, static_cast<uint32_t>(offsetof(InstanceData, normalMatrix) + column * sizeof(glm::vec4)) });
+    }
+
+    instancedConfig->renderPass = m_RenderPass;
+    instancedConfig->pipelineLayout = m_PipelineLayot;
+    m_InstancedPipelines[index] = pipelines.RequestGraphics(
+        s_InstancedVertexShaders[index],
+        "C:/dev/VkTest/VkTest/src/Shaders/spv.frag",
+        std::move(instancedConfig));
+
+    if (m_IndirectSupported) {
+        auto indirectConfig = std::make_unique<PipelineConfigInfo>();
+        Pipeline::DefaultPipelineConfigInfo(*indirectConfig);
+        SetVertexInput(*indirectConfig, format);
+
+        indirectConfig->renderPass = m_RenderPass;
+        indirectConfig->pipelineLayout = m_IndirectPipelineLayout;
+        m_IndirectPipelines[index] = pipelines.RequestGraphics(
+            s_IndirectVertexShaders[index],
+            "C:/dev/VkTest/VkTest/src/Shaders/spv.frag",
+            std::move(indirectConfig));
+    }
+}
+
+void RenderSystem::CreatePipelineLayout() {
+    VkPushConstantRange pushConstantRange{};
+    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    pushConstantRange.offset = 0;
+    pushConstantRange.size = sizeof(PushConstantData);
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    pipelineLayoutInfo.setLayoutCount = 0;
+    pipelineLayoutInfo.pSetLayouts = nullptr;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+    if (vkCreatePipelineLayout(m_Device.GetDevice(), &pipelineLayoutInfo, nullptr, &m_PipelineLayot) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create pipeline layout");
+    }
+}
+
+void RenderSystem::CreateIndirectResources() {
+    VkDescriptorSetLayoutBinding bindings[4]{};
+    for (uint32_t i = 0; i < 4; i++) {
+        bindings[i].binding = i;
+        bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        bindings[i].descriptorCount = 1;
+        bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT;
+    }
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo{};
+    setLayoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    setLayoutInfo.bindingCount = 4;
+    setLayoutInfo.pBindings = bindings;
+
+    if (vkCreateDescriptorSetLayout(m_Device.GetDevice(), &setLayoutInfo, nullptr, &m_IndirectSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create descriptor set layout");
+    }
+
+    VkDescriptorPoolSize poolSize{};
+    poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    poolSize.descriptorCount = 4 * SwapChain::MAX_FRAMES_IN_FLIGHT;
+
+    VkDescriptorPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolInfo.maxSets = SwapChain::MAX_FRAMES_IN_FLIGHT;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
+
+    if (vkCreateDescriptorPool(m_Device.GetDevice(), &poolInfo, nullptr, &m_IndirectDescriptorPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create descriptor pool");
+    }
+
+    std::array<VkDescriptorSetLayout, SwapChain::MAX_FRAMES_IN_FLIGHT> setLayouts{};
+    setLayouts.fill(m_IndirectSetLayout);
+    std::array<VkDescriptorSet, SwapChain::MAX_FRAMES_IN_FLIGHT> sets{};
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorPool = m_IndirectDescriptorPool;
+    allocInfo.descriptorSetCount = static_cast<uint32_t>(setLayouts.size());
+    allocInfo.pSetLayouts = setLayouts.data();
+
+    if (vkAllocateDescriptorSets(m_Device.GetDevice(), &allocInfo, sets.data()) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate descriptor sets");
+    }
+    for (size_t i = 0; i < sets.size(); i++) {
+        m_IndirectFrames[i].descriptorSet = sets[i];
+    }
+
+    VkPushConstantRange drawPushRange{};
+    drawPushRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
+    drawPushRange.offset = 0;
+    drawPushRange.size = sizeof(PushConstantData);
+
+    VkPipelineLayoutCreateInfo drawLayoutInfo{};
+    drawLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    drawLayoutInfo.setLayoutCount = 1;
+    drawLayoutInfo.pSetLayouts = &m_IndirectSetLayout;
+    drawLayoutInfo.pushConstantRangeCount = 1;
+    drawLayoutInfo.pPushConstantRanges = &drawPushRange;
+
+    if (vkCreatePipelineLayout(m_Device.GetDevice(), &drawLayoutInfo, nullptr, &m_IndirectPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create pipeline layout");
+    }
+
+    VkPushConstantRange cullPushRange{};
+    cullPushRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    cullPushRange.offset = 0;
+    cullPushRange.size = sizeof(CullPushConstantData);
+
+    VkPipelineLayoutCreateInfo cullLayoutInfo{};
+    cullLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+    cullLayoutInfo.setLayoutCount = 1;
+    cullLayoutInfo.pSetLayouts = &m_IndirectSetLayout;
+    cullLayoutInfo.pushConstantRangeCount = 1;
+    cullLayoutInfo.pPushConstantRanges = &cullPushRange;
+
+    if (vkCreatePipelineLayout(m_Device.GetDevice(), &cullLayoutInfo, nullptr, &m_CullPipelineLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create pipeline layout");
+    }
+
+    m_CullPipeline = m_Device.GetPipelineManager().RequestCompute(
+        "C:/dev/VkTest/VkTest/src/Shaders/spv_cull.comp",
+        m_CullPipelineLayout);
+
+    if (m_Device.SupportsDrawIndirectCount()) {
+        m_pfnDrawIndexedIndirectCount = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+            vkGetDeviceProcAddr(m_Device.GetDevice(), "vkCmdDrawIndexedIndirectCountKHR"));
+    }
 }
\ No newline at end of file
@@ -1,34 +1,162 @@
-#pragma once
-
-#include <Core/Device.h>
-#include <Core/Pipeline.h>
-#include <Core/GameObject.h>
-#include <Core/Camera.h>
-
-#include <memory>
-#include <vector>
-
-class RenderSystem {
-public:
-    RenderSystem(Device& device, VkRenderPass renderPass);
-    ~RenderSystem();
-
-    RenderSystem(const RenderSystem&) = delete;
-    RenderSystem& operator=(const RenderSystem&) = delete;
-
-    RenderSystem(RenderSystem&&) = delete;
-    RenderSystem& operator=(RenderSystem&&) = delete;
-public:
-    void RenderGameObjects(
-        VkCommandBuffer commandBuffer, 
-        std::vector<GameObject>& gameObjects,
-        Camera& camera
-    );
-private:
-    void CreatePipeline(VkRenderPass renderPass);
-    void CreatePipelineLayout();
-private:
-    Device&						m_Device;
-    std::unique_ptr<Pipeline>	m_pPipeline;
-    VkPipelineLayout			m_PipelineLayot;
+#pragma once
+
+#include <Core/Device.h>
+#include <Core/Pipeline.h>
+#include <Core/PipelineManager.h>
+#include <Core/Components.h>
+#include <Core/Scene.h>
+#include <Core/Camera.h>
+#include <Core/FrameInfo.h>
+#include <Core/SwapChain.h>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+class RenderSystem {
+public:
+    enum class RenderMode {
+        Direct,     // push constants and one draw per object
+        Instanced,  // one draw per unique model, transforms in a per-frame instance buffer
+        Indirect,   // compute shader culls and writes the draws, CPU records a single indirect call
+        Parallel    // like Direct, recorded into secondary command buffers on the thread pool, needs FrameInfo::frameContext
+    };
+public:
+    RenderSystem(Device& device, VkRenderPass renderPass);
+    ~RenderSystem();
+
+    RenderSystem(const RenderSystem&) = delete;
+    RenderSystem& operator=(const RenderSystem&) = delete;
+
+    RenderSystem(RenderSystem&&) = delete;
+    RenderSystem& operator=(RenderSystem&&) = delete;
+public:
+    // Picks this frame's mode from the pipelines that have finished compiling and records
+    // work that has to happen outside the render pass, the GPU cull pass for Indirect.
+    // Has to run every frame before RenderGameObjects.
+    void PrepareGameObjects(FrameInfo& frameInfo, Scene& scene);
+    void RenderGameObjects(FrameInfo& frameInfo, Scene& scene);
+
+    // Indirect needs drawIndirectFirstInstance and falls back to Instanced without it.
+    // While pipelines compile, frames fall back to Instanced and then Direct.
+    void SetRenderMode(RenderMode mode);
+    RenderMode GetRenderMode() const { return m_RenderMode; }
+    // What the render pass has to be begun with for the mode picked by PrepareGameObjects
+    VkSubpassContents GetSubpassContents() const;
+
+    // Projected bounding sphere radius, as a fraction of half the viewport height, below which
+    // objects move to coarser levels of detail. 0 always draws the full mesh.
+    void SetLodScreenSize(float screenSize) { m_LodScreenSize = screenSize; }
+    float GetLodScreenSize() const { return m_LodScreenSize; }
+private:
+    struct FrameBuffer {
+        VkBuffer         buffer = VK_NULL_HANDLE;
+        MemoryAllocation memory{};
+        VkDeviceSize     size = 0;
+    };
+
+    // Objects drawn with the same pipeline from the same pool page, one binding each
+    struct IndirectBatch {
+        GeometryPool*       pool = nullptr;
+        uint32_t            page = 0;
+        VkIndexType         indexType = VK_INDEX_TYPE_UINT32;
+        Model::VertexFormat format = Model::VertexFormat::Full;
+        uint32_t            firstObject = 0;
+        uint32_t            objectCount = 0;
+    };
+
+    struct IndirectFrame {
+        FrameBuffer      objects;   // host visible, written every frame
+        FrameBuffer      meshes;    // host visible
+        FrameBuffer      draws;     // written by the cull shader
+        FrameBuffer      drawCounts; // one per batch
+        VkDescriptorSet  descriptorSet = VK_NULL_HANDLE;
+        uint32_t         objectCount = 0;
+        std::vector<IndirectBatch> batches;
+    };
+
+    struct IndirectSource {
+        const WorldTransformComponent* transform;
+        const Model* model;
+        uint32_t meshIndex;
+        uint32_t group;
+    };
+
+    // One pipeline per Model::VertexFormat
+    using FormatPipelines = std::array<PipelineManager::Handle, Model::s_VertexFormatCount>;
+    using FormatPipelineRefs = std::array<Pipeline*, Model::s_VertexFormatCount>;
+private:
+    std::optional<RenderMode> ResolveRenderMode();
+    bool IsReady(const FormatPipelines& handles, Model::VertexFormat format);
+    // Null for formats whose pipeline was never requested or is still compiling
+    FormatPipelineRefs GetPipelines(const FormatPipelines& handles);
+    // Full is requested up front, other formats the first time one of their models shows up
+    void RequestPipelines(Model::VertexFormat format);
+    // Requests the format's pipelines if needed, false while this frame's pipeline for it is missing
+    bool CanDraw(Model::VertexFormat format);
+    // Tests every ready object against the camera frustum, survivors end up in m_VisibleObjects
+    void CullGameObjects(FrameInfo& frameInfo, Scene& scene);
+    void RenderDirect(FrameInfo& frameInfo, Scene& scene);
+    void RenderInstanced(FrameInfo& frameInfo, Scene& scene);
+    void RenderIndirect(FrameInfo& frameInfo);
+    void RenderParallel(FrameInfo& frameInfo, Scene& scene);
+    // Adds its draws and geometry binds to stats
+    void RecordDirect(
+        VkCommandBuffer commandBuffer,
+        const FormatPipelineRefs& pipelines,
+        const glm::mat4& projectionView,
+        size_t begin,
+        size_t end,
+        FrameStats& stats);
+    void CullIndirect(FrameInfo& frameInfo, Scene& scene);
+
+    void ReserveBuffer(FrameBuffer& frameBuffer, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties);
+    void DestroyBuffer(FrameBuffer& frameBuffer);
+
+    void CreatePipelineLayout();
+    void CreateIndirectResources();
+private:
+    Device&						m_Device;
+    FormatPipelines				m_Pipelines{ PipelineManager::s_InvalidHandle, PipelineManager::s_InvalidHandle };
+    FormatPipelines				m_InstancedPipelines{ PipelineManager::s_InvalidHandle, PipelineManager::s_InvalidHandle };
+    VkPipelineLayout			m_PipelineLayot;
+    VkRenderPass				m_RenderPass;
+    RenderMode					m_RenderMode = RenderMode::Instanced;
+    std::optional<RenderMode>	m_FrameRenderMode;
+    FormatPipelineRefs			m_FramePipelines{};     // of m_FrameRenderMode
+    float						m_LodScreenSize = 0.25f;
+
+    std::array<FrameBuffer, SwapChain::MAX_FRAMES_IN_FLIGHT>	m_InstanceBuffers;
+    std::vector<std::pair<Model*, uint32_t>>					m_DrawOrder;
+
+    // CPU culling scratch, indexed by cull slot. Spheres are split per component for SIMD.
+    std::vector<Model*>			m_CullModels;
+    std::vector<const WorldTransformComponent*>	m_CullSources;
+    std::vector<float>			m_CullSphereX;
+    std::vector<float>			m_CullSphereY;
+    std::vector<float>			m_CullSphereZ;
+    std::vector<float>			m_CullSphereRadius;
+    std::vector<uint8_t>		m_CullVisible;
+    std::vector<uint32_t>		m_CullLods;         // only set for visible slots
+    std::vector<uint32_t>		m_VisibleObjects;   // cull slots that passed
+
+    bool						m_IndirectSupported = false;
+    FormatPipelines				m_IndirectPipelines{ PipelineManager::s_InvalidHandle, PipelineManager::s_InvalidHandle };
+    PipelineManager::Handle		m_CullPipeline = PipelineManager::s_InvalidHandle;
+    VkPipelineLayout			m_IndirectPipelineLayout = VK_NULL_HANDLE;
+    VkPipelineLayout			m_CullPipelineLayout = VK_NULL_HANDLE;
+    VkDescriptorSetLayout		m_IndirectSetLayout = VK_NULL_HANDLE;
+    VkDescriptorPool			m_IndirectDescriptorPool = VK_NULL_HANDLE;
+    PFN_vkCmdDrawIndexedIndirectCountKHR m_pfnDrawIndexedIndirectCount = nullptr;
+
+    std::array<IndirectFrame, SwapChain::MAX_FRAMES_IN_FLIGHT>	m_IndirectFrames;
+    std::vector<VkCommandBuffer>								m_SecondaryBuffers;
+    std::vector<FrameStats>										m_RecorderStats;    // one per secondary buffer
+    std::unordered_map<Model*, uint32_t>						m_MeshIndices;
+    std::vector<IndirectSource>									m_IndirectObjects;
+    std::vector<uint32_t>										m_GroupCursors;
+    std::vector<uint32_t>										m_GroupBatches;
+    std::vector<const Model*>									m_GroupModels;
 };
\ No newline at end of file
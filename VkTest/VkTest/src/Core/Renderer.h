@@ -1,42 +1,55 @@
-#pragma once
-
-#include <Core/Device.h>
-#include <Core/SwapChain.h>
-#include <Core/Window.h>
-
-#include <memory>
-#include <vector>
-
-class Renderer {
-public:
-    Renderer(Window& window, Device& device);
-    ~Renderer();
-
-    Renderer(const Renderer&) = delete;
-    Renderer& operator=(const Renderer&) = delete;
-
-    Renderer(Renderer&&) = delete;
-    Renderer& operator=(Renderer&&) = delete;
-public:
-    VkCommandBuffer BeginFrame();
-    void EndFrame();
-    void BeginSwapChainRenderPass(VkCommandBuffer commandBuffer);
-    void EndSwapChainRenderPass(VkCommandBuffer commandBuffer);
-    bool IsFrameInProgress() const;
-    VkCommandBuffer GetCurrentCommandBuffer() const;
-    VkRenderPass GetSwapChainRenderPass() const;
-    uint32_t GetFrameIndex() const;
-    float GetAspectRatio() const;
-private:
-    void CreateCommandBuffers();
-    void RecreateSwapChain();
-    void FreeCommandBuffer();
-private:
-    Window&						 m_Window;
-    Device&						 m_Device;
-    std::unique_ptr<SwapChain>	 m_pSwapChain;
-    std::vector<VkCommandBuffer> m_CommandBuffers;
-    uint32_t					 m_CurrentImageIndex;
-    uint32_t					 m_CurrentFrameIndex = 0;
-    bool						 m_IsFrameStarted = false;
+#pragma once
+
+#include <Core/Device.h>
+#include <Core/FrameContext.h>
+#include <Core/OffscreenTarget.h>
+#include <Core/SwapChain.h>
+#include <Core/Window.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Renderer {
+public:
+    Renderer(Window& window, Device& device);
+    // Headless, renders into offscreen images of a fixed extent instead of a swap chain
+    Renderer(Device& device, VkExtent2D extent);
+    ~Renderer();
+
+    Renderer(const Renderer&) = delete;
+    Renderer& operator=(const Renderer&) = delete;
+
+    Renderer(Renderer&&) = delete;
+    Renderer& operator=(Renderer&&) = delete;
+public:
+    VkCommandBuffer BeginFrame();
+    void EndFrame();
+    // With secondary contents, viewport and scissor are left to the secondary buffers
+    void BeginSwapChainRenderPass(VkCommandBuffer commandBuffer, VkSubpassContents contents = VK_SUBPASS_CONTENTS_INLINE);
+    void EndSwapChainRenderPass(VkCommandBuffer commandBuffer);
+    bool IsFrameInProgress() const;
+    VkCommandBuffer GetCurrentCommandBuffer() const;
+    // Recycled at the start of the frame that next uses the same index
+    FrameContext& GetCurrentFrameContext() const;
+    VkRenderPass GetSwapChainRenderPass() const;
+    uint32_t GetFrameIndex() const;
+    float GetAspectRatio() const;
+    VkExtent2D GetSwapChainExtent() const;
+    bool IsHeadless() const { return m_pWindow == nullptr; }
+    // Headless only, RGBA8 of the last frame that was ended
+    void ReadPixels(std::vector<uint8_t>& pixels);
+private:
+    void CreateFrameContexts();
+    void RecreateSwapChain();
+private:
+    Window*						 m_pWindow = nullptr;
+    Device&						 m_Device;
+    std::unique_ptr<SwapChain>	 m_pSwapChain;
+    std::unique_ptr<OffscreenTarget> m_pOffscreenTarget;
+    std::vector<std::unique_ptr<FrameContext>> m_FrameContexts;
+    VkCommandBuffer				 m_CurrentCommandBuffer = VK_NULL_HANDLE;
+    uint32_t					 m_CurrentImageIndex;
+    uint32_t					 m_CurrentFrameIndex = 0;
+    bool						 m_IsFrameStarted = false;
 };
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "Scene.h"
+
+Entity Scene::Create() {
+    Entity entity{};
+    if (!m_FreeIndices.empty()) {
+        entity.index = m_FreeIndices.back();
+        m_FreeIndices.pop_back();
+    }
+    else {
+        entity.index = static_cast<uint32_t>(m_Generations.size());
+        m_Generations.push_back(0);
+    }
+    entity.generation = m_Generations[entity.index];
+
+    return entity;
+}
+
+void Scene::Destroy(Entity entity) {
+    if (!IsAlive(entity)) {
+        return;
+    }
+
+    for (auto& pool : m_Pools) {
+        if (pool) {
+            pool->Remove(entity);
+        }
+    }
+
+    m_Generations[entity.index]++;
+    m_FreeIndices.push_back(entity.index);
+}
+
+bool Scene::IsAlive(Entity entity) const {
+    return entity.index < m_Generations.size() && m_Generations[entity.index] == entity.generation;
+}
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Stable handle to an entity. The index is recycled after Destroy(), the generation
+// makes stale handles to the old occupant fail IsAlive().
+struct Entity {
+    static constexpr uint32_t s_InvalidIndex = UINT32_MAX;
+
+    uint32_t index = s_InvalidIndex;
+    uint32_t generation = 0;
+
+    bool IsValid() const { return index != s_InvalidIndex; }
+    bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Entity& other) const { return !(*this == other); }
+};
+
+class ComponentPoolBase {
+public:
+    virtual ~ComponentPoolBase() = default;
+    virtual void Remove(Entity entity) = 0;
+};
+
+// Sparse set: m_Sparse maps an entity index to its slot in the dense arrays, which hold
+// every component of this type back to back. Removal swaps the last element into the hole.
+// Lookups compare the generation stored with the slot, so a stale handle finds nothing.
+template <typename T>
+class ComponentPool : public ComponentPoolBase {
+public:
+    static constexpr uint32_t s_Empty = UINT32_MAX;
+public:
+    template <typename... Args>
+    T& Emplace(Entity entity, Args&&... args);
+    void Remove(Entity entity) override;
+
+    bool Has(Entity entity) const {
+        return entity.index < m_Sparse.size() &&
+            m_Sparse[entity.index] != s_Empty &&
+            m_Entities[m_Sparse[entity.index]] == entity;
+    }
+    T& Get(Entity entity) {
+        if (!Has(entity)) {
+            throw std::runtime_error("Entity has no such component!");
+        }
+        return m_Components[m_Sparse[entity.index]];
+    }
+    T* TryGet(Entity entity) { return Has(entity) ? &m_Components[m_Sparse[entity.index]] : nullptr; }
+
+    // Dense views for linear iteration, component i belongs to Entities()[i]
+    size_t Size() const { return m_Components.size(); }
+    T* Data() { return m_Components.data(); }
+    const Entity* Entities() const { return m_Entities.data(); }
+private:
+    std::vector<uint32_t>   m_Sparse;
+    std::vector<Entity>     m_Entities;
+    std::vector<T>          m_Components;
+};
+
+// Owns every entity and one ComponentPool per component type that has been used
+class Scene {
+public:
+    Scene() = default;
+    ~Scene() = default;
+
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+
+    Scene(Scene&&) = delete;
+    Scene& operator=(Scene&&) = delete;
+public:
+    Entity Create();
+    void Destroy(Entity entity);
+    bool IsAlive(Entity entity) const;
+    size_t GetEntityCount() const { return m_Generations.size() - m_FreeIndices.size(); }
+
+    template <typename T, typename... Args>
+    T& Add(Entity entity, Args&&... args) {
+        if (!IsAlive(entity)) {
+            throw std::runtime_error("Entity is not alive!");
+        }
+        return GetPool<T>().Emplace(entity, std::forward<Args>(args)...);
+    }
+    template <typename T>
+    void Remove(Entity entity) { GetPool<T>().Remove(entity); }
+    template <typename T>
+    bool Has(Entity entity) { return GetPool<T>().Has(entity); }
+    template <typename T>
+    T& Get(Entity entity) { return GetPool<T>().Get(entity); }
+    template <typename T>
+    T* TryGet(Entity entity) { return GetPool<T>().TryGet(entity); }
+
+    template <typename T>
+    ComponentPool<T>& GetPool();
+
+    // Calls fn(entity, first&, rest&...) for every entity that has all of the components.
+    // Walks the dense array of the first type, so put the rarest component first.
+    template <typename First, typename... Rest, typename F>
+    void Each(F&& fn);
+private:
+    static uint32_t NextTypeId() {
+        static uint32_t nextId = 0;
+        return nextId++;
+    }
+
+    template <typename T>
+    static uint32_t TypeId() {
+        static const uint32_t id = NextTypeId();
+        return id;
+    }
+private:
+    std::vector<uint32_t>                           m_Generations;
+    std::vector<uint32_t>                           m_FreeIndices;
+    std::vector<std::unique_ptr<ComponentPoolBase>> m_Pools;    // indexed by TypeId
+};
+
+template <typename T>
+template <typename... Args>
+T& ComponentPool<T>::Emplace(Entity entity, Args&&... args) {
+    if (Has(entity)) {
+        return m_Components[m_Sparse[entity.index]] = T{ std::forward<Args>(args)... };
+    }
+
+    if (entity.index >= m_Sparse.size()) {
+        m_Sparse.resize(entity.index + 1, s_Empty);
+    }
+    if (m_Sparse[entity.index] != s_Empty) {
+        throw std::runtime_error("Component slot belongs to another generation of the entity!");
+    }
+
+    m_Sparse[entity.index] = static_cast<uint32_t>(m_Components.size());
+    m_Entities.push_back(entity);
+    return m_Components.emplace_back(T{ std::forward<Args>(args)... });
+}
+
+template <typename T>
+void ComponentPool<T>::Remove(Entity entity) {
+    if (!Has(entity)) {
+        return;
+    }
+
+    const uint32_t slot = m_Sparse[entity.index];
+    const uint32_t last = static_cast<uint32_t>(m_Components.size() - 1);
+    if (slot != last) {
+        m_Components[slot] = std::move(m_Components[last]);
+        m_Entities[slot] = m_Entities[last];
+        m_Sparse[m_Entities[slot].index] = slot;
+    }
+
+    m_Components.pop_back();
+    m_Entities.pop_back();
+    m_Sparse[entity.index] = s_Empty;
+}
+
+template <typename T>
+ComponentPool<T>& Scene::GetPool() {
+    const uint32_t id = TypeId<T>();
+    if (id >= m_Pools.size()) {
+        m_Pools.resize(id + 1);
+    }
+    if (!m_Pools[id]) {
+        m_Pools[id] = std::make_unique<ComponentPool<T>>();
+    }
+
+    return static_cast<ComponentPool<T>&>(*m_Pools[id]);
+}
+
+template <typename First, typename... Rest, typename F>
+void Scene::Each(F&& fn) {
+    auto& first = GetPool<First>();
+    std::tuple<ComponentPool<Rest>&...> rest{ GetPool<Rest>()... };
+
+    // Indexed rather than iterated, fn may add components of other types
+    for (size_t i = 0; i < first.Size(); i++) {
+        const Entity entity = first.Entities()[i];
+        const auto components = std::apply([&](auto&... pools) { return std::make_tuple(pools.TryGet(entity)...); }, rest);
+        const bool hasAll = std::apply([](auto*... component) { return ((component != nullptr) && ...); }, components);
+        if (hasAll) {
+            std::apply([&](auto*... component) { fn(entity, first.Data()[i], *component...); }, components);
+        }
+    }
+}
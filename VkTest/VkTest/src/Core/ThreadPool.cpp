@@ -0,0 +1,120 @@
+#include "ThreadPool.h"
+#include <Core/Trace.h>
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(uint32_t threadCount) {
+    threadCount = std::max(threadCount, 1u);
+
+    m_Workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; i++) {
+        m_Workers.emplace_back([this, i]() {
+            TRACE_THREAD("Worker " + std::to_string(i));
+            WorkerLoop();
+        });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock{ m_Mutex };
+        m_Stop = true;
+    }
+    m_Condition.notify_all();
+
+    for (auto& worker : m_Workers) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::Get() {
+    static ThreadPool pool{};
+    return pool;
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) {
+        return;
+    }
+
+    grainSize = std::max<size_t>(grainSize, 1);
+    const size_t chunkCount = (count + grainSize - 1) / grainSize;
+    if (chunkCount == 1) {
+        fn(0, count);
+        return;
+    }
+
+    struct State {
+        std::atomic<size_t>     nextChunk{ 0 };
+        std::atomic<size_t>     doneChunks{ 0 };
+        std::mutex              mutex;
+        std::condition_variable condition;
+        std::exception_ptr      exception;
+    };
+    auto state = std::make_shared<State>();
+
+    // Helpers that start after every chunk was taken return without touching fn,
+    // so capturing it by reference is safe once the caller has left.
+    auto runChunks = [state, count, grainSize, chunkCount, &fn]() {
+        size_t chunk;
+        while ((chunk = state->nextChunk.fetch_add(1)) < chunkCount) {
+            const size_t begin = chunk * grainSize;
+            const size_t end = std::min(begin + grainSize, count);
+            try {
+                fn(begin, end);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock{ state->mutex };
+                if (!state->exception) {
+                    state->exception = std::current_exception();
+                }
+            }
+
+            if (state->doneChunks.fetch_add(1) + 1 == chunkCount) {
+                std::lock_guard<std::mutex> lock{ state->mutex };
+                state->condition.notify_all();
+            }
+        }
+    };
+
+    const size_t helperCount = std::min<size_t>(chunkCount - 1, m_Workers.size());
+    for (size_t i = 0; i < helperCount; i++) {
+        Enqueue(runChunks);
+    }
+
+    runChunks();
+
+    std::unique_lock<std::mutex> lock{ state->mutex };
+    state->condition.wait(lock, [&state, chunkCount]() { return state->doneChunks.load() == chunkCount; });
+
+    if (state->exception) {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+void ThreadPool::Enqueue(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock{ m_Mutex };
+        m_Tasks.push_back(std::move(task));
+    }
+    m_Condition.notify_one();
+}
+
+void ThreadPool::WorkerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock{ m_Mutex };
+            m_Condition.wait(lock, [this]() { return m_Stop || !m_Tasks.empty(); });
+
+            if (m_Stop && m_Tasks.empty()) {
+                return;
+            }
+
+            task = std::move(m_Tasks.front());
+            m_Tasks.pop_front();
+        }
+
+        task();
+    }
+}
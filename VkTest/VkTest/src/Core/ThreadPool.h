@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class ThreadPool {
+public:
+    explicit ThreadPool(uint32_t threadCount = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+public:
+    static ThreadPool& Get();
+
+    template <typename F>
+    auto Submit(F&& task) -> std::future<std::invoke_result_t<F>>;
+
+    // Splits [0, count) into chunks of grainSize and runs fn(begin, end) on the workers.
+    // The calling thread takes chunks too, so ParallelFor may be nested inside pool tasks.
+    void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t, size_t)>& fn);
+
+    uint32_t GetThreadCount() const { return static_cast<uint32_t>(m_Workers.size()); }
+private:
+    void Enqueue(std::function<void()> task);
+    void WorkerLoop();
+private:
+    std::vector<std::thread>            m_Workers;
+    std::deque<std::function<void()>>   m_Tasks;
+    std::mutex                          m_Mutex;
+    std::condition_variable             m_Condition;
+    bool                                m_Stop = false;
+};
+
+template <typename F>
+auto ThreadPool::Submit(F&& task) -> std::future<std::invoke_result_t<F>> {
+    using Result = std::invoke_result_t<F>;
+
+    auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+    auto future = packaged->get_future();
+    Enqueue([packaged]() { (*packaged)(); });
+
+    return future;
+}
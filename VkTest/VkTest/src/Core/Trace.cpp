@@ -0,0 +1,154 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+    // Relaxed atomics so the exporter may read a slot while the owner overwrites it
+    struct Slot {
+        std::atomic<const char*>    name{ nullptr };
+        std::atomic<uint64_t>       begin{ 0 };
+        std::atomic<uint64_t>       end{ 0 };
+    };
+
+    // Single producer ring, only the owning thread writes slots and head
+    struct ThreadBuffer {
+        std::unique_ptr<Slot[]>         slots{ new Slot[Trace::s_BufferCapacity] };
+        std::atomic<uint64_t>           head{ 0 };
+        uint32_t                        threadId = 0;
+        std::string                     name;   // guarded by the registry mutex
+    };
+
+    struct Registry {
+        std::mutex                                  mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>>  buffers;
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    };
+
+    // Never destroyed, pool threads may still close zones during static destruction
+    Registry& GetRegistry() {
+        static Registry* registry = new Registry{};
+        return *registry;
+    }
+
+    // Registration is the only locked step and happens once per thread
+    ThreadBuffer& GetThreadBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (buffer == nullptr) {
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock{ registry.mutex };
+
+            auto newBuffer = std::make_unique<ThreadBuffer>();
+            newBuffer->threadId = static_cast<uint32_t>(registry.buffers.size());
+            newBuffer->name = "Thread " + std::to_string(newBuffer->threadId);
+            buffer = newBuffer.get();
+            registry.buffers.push_back(std::move(newBuffer));
+        }
+        return *buffer;
+    }
+
+    void WriteJsonString(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20) {
+                out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+            }
+            else {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+}
+
+uint64_t Trace::Now() {
+    const auto elapsed = std::chrono::steady_clock::now() - GetRegistry().start;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+void Trace::Record(const char* name, uint64_t begin, uint64_t end) {
+    ThreadBuffer& buffer = GetThreadBuffer();
+
+    const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+    Slot& slot = buffer.slots[head % s_BufferCapacity];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(begin, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void Trace::SetThreadName(const std::string& name) {
+    ThreadBuffer& buffer = GetThreadBuffer();
+
+    std::lock_guard<std::mutex> lock{ GetRegistry().mutex };
+    buffer.name = name;
+}
+
+bool Trace::WriteChromeTrace(const std::string& filepath) {
+    std::ofstream file{ filepath, std::ios::trunc };
+    if (!file) {
+        return false;
+    }
+
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock{ registry.mutex };
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    file << std::fixed << std::setprecision(3);
+
+    bool first = true;
+    size_t zoneCount = 0;
+    std::vector<Event> events{};
+    for (const auto& buffer : registry.buffers) {
+        file << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+            << ",\"args\":{\"name\":";
+        WriteJsonString(file, buffer->name);
+        file << "}}";
+        first = false;
+
+        const uint64_t head = buffer->head.load(std::memory_order_acquire);
+        const uint64_t begin = head > s_BufferCapacity ? head - s_BufferCapacity : 0;
+        events.clear();
+        for (uint64_t i = begin; i < head; i++) {
+            const Slot& slot = buffer->slots[i % s_BufferCapacity];
+            events.push_back(Event{
+                slot.name.load(std::memory_order_relaxed),
+                slot.begin.load(std::memory_order_relaxed),
+                slot.end.load(std::memory_order_relaxed) });
+        }
+
+        // The owner kept recording while we copied, anything it wrapped around onto is torn,
+        // including the slot it may be writing right now
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t headAfter = buffer->head.load(std::memory_order_acquire) + 1;
+        const uint64_t validBegin = headAfter > s_BufferCapacity ? headAfter - s_BufferCapacity : 0;
+
+        for (uint64_t i = std::max(begin, validBegin); i < head; i++) {
+            const Event& event = events[i - begin];
+            file << ",\n{\"name\":";
+            WriteJsonString(file, event.name);
+            file << ",\"cat\":\"cpu\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"ts\":" << static_cast<double>(event.begin) * 1e-3
+                << ",\"dur\":" << static_cast<double>(event.end - event.begin) * 1e-3 << "}";
+            zoneCount++;
+        }
+    }
+
+    file << "\n]}\n";
+    if (!file) {
+        return false;
+    }
+
+    std::cout << "trace: wrote " << zoneCount << " zones to " << filepath << std::endl;
+    return true;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Zones are recorded in debug builds only unless TRACE_ENABLED is defined, in release the
+// macros below expand to nothing and never touch the per-thread buffers
+#ifndef TRACE_ENABLED
+#ifdef NDEBUG
+#define TRACE_ENABLED 0
+#else
+#define TRACE_ENABLED 1
+#endif
+#endif
+
+// Scoped CPU zones for finding where frame and startup time goes. Every thread records into
+// its own ring buffer without locking, the newest s_BufferCapacity zones per thread survive.
+// WriteChromeTrace dumps them as Chrome trace_event JSON, for chrome://tracing or Perfetto.
+class Trace {
+public:
+    static constexpr uint32_t s_BufferCapacity = 1u << 16;
+
+    struct Event {
+        const char* name = nullptr;     // has to outlive the trace, zones take string literals
+        uint64_t    begin = 0;          // nanoseconds since the first zone
+        uint64_t    end = 0;
+    };
+
+    class Zone {
+    public:
+        explicit Zone(const char* name) : m_Name{ name }, m_Begin{ Now() } {}
+        ~Zone() { Record(m_Name, m_Begin, Now()); }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+    private:
+        const char* m_Name;
+        uint64_t    m_Begin;
+    };
+public:
+    static uint64_t Now();
+    static void Record(const char* name, uint64_t begin, uint64_t end);
+    // Shown instead of the thread number, applies to the calling thread
+    static void SetThreadName(const std::string& name);
+    // Safe while other threads record, zones they overwrite during the copy are dropped
+    static bool WriteChromeTrace(const std::string& filepath);
+};
+
+#if TRACE_ENABLED
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_ZONE(name) Trace::Zone TRACE_CONCAT(traceZone, __LINE__){ name }
+#define TRACE_THREAD(name) Trace::SetThreadName(name)
+#else
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_THREAD(name) ((void)0)
+#endif
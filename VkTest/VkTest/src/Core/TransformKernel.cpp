@@ -0,0 +1,331 @@
+#include "TransformKernel.h"
+#include <Core/CpuFeatures.h>
+
+#if VKTEST_X86
+#include <immintrin.h>
+#endif
+
+#include <cmath>
+#include <cstdint>
+
+// Cephes style sincos: reduce by pi/2 in three parts, then minimax polynomials on
+// [-pi/4, pi/4]. About 1e-7 absolute error for the angle range a transform sees.
+static constexpr float s_TwoOverPi = 0.636619772367581343f;
+static constexpr float s_PiOver2A = 1.5703125f;
+static constexpr float s_PiOver2B = 4.837512969970703125e-4f;
+static constexpr float s_PiOver2C = 7.54978995489188216e-8f;
+
+static constexpr float s_SinC1 = -1.6666654611e-1f;
+static constexpr float s_SinC2 = 8.3321608736e-3f;
+static constexpr float s_SinC3 = -1.9515295891e-4f;
+static constexpr float s_CosC1 = 4.166664568298827e-2f;
+static constexpr float s_CosC2 = -1.388731625493765e-3f;
+static constexpr float s_CosC3 = 2.443315711809948e-5f;
+
+static inline char* OutputAt(glm::mat4* base, size_t index, size_t stride) {
+    return reinterpret_cast<char*>(base) + index * stride;
+}
+
+static inline void SinCosScalar(float x, float& sine, float& cosine) {
+    const int32_t quadrant = static_cast<int32_t>(std::nearbyint(x * s_TwoOverPi));
+    const float q = static_cast<float>(quadrant);
+    const float r = ((x - q * s_PiOver2A) - q * s_PiOver2B) - q * s_PiOver2C;
+    const float r2 = r * r;
+
+    const float s = r + r * r2 * (s_SinC1 + r2 * (s_SinC2 + r2 * s_SinC3));
+    const float c = 1.0f - 0.5f * r2 + r2 * r2 * (s_CosC1 + r2 * (s_CosC2 + r2 * s_CosC3));
+
+    switch (quadrant & 3) {
+    case 0: sine = s;  cosine = c;  break;
+    case 1: sine = c;  cosine = -s; break;
+    case 2: sine = -s; cosine = -c; break;
+    default: sine = -c; cosine = s; break;
+    }
+}
+
+void TransformKernel::Streams::Clear() {
+    for (int i = 0; i < 3; i++) {
+        translation[i].clear();
+        rotation[i].clear();
+        scale[i].clear();
+    }
+}
+
+void TransformKernel::Streams::Push(const glm::vec3& translationValue, const glm::vec3& rotationValue, const glm::vec3& scaleValue) {
+    for (int i = 0; i < 3; i++) {
+        translation[i].push_back(translationValue[i]);
+        rotation[i].push_back(rotationValue[i]);
+        scale[i].push_back(scaleValue[i]);
+    }
+}
+
+TransformKernel::Input TransformKernel::Streams::GetInput() const {
+    Input input{};
+    for (int i = 0; i < 3; i++) {
+        input.translation[i] = translation[i].data();
+        input.rotation[i] = rotation[i].data();
+        input.scale[i] = scale[i].data();
+    }
+    return input;
+}
+
+void TransformKernel::Compute(const Input& input, size_t count, const Output& output) {
+#if VKTEST_X86
+    if (CpuFeatures::Get().avx2) {
+        ComputeAvx2(input, count, output);
+        return;
+    }
+    ComputeSse(input, count, output);
+#else
+    ComputeScalar(input, 0, count, output);
+#endif
+}
+
+void TransformKernel::ComputeScalar(const Input& input, size_t begin, size_t end, const Output& output) {
+    for (size_t i = begin; i < end; i++) {
+        float s1, c1, s2, c2, s3, c3;
+        SinCosScalar(input.rotation[1][i], s1, c1);
+        SinCosScalar(input.rotation[0][i], s2, c2);
+        SinCosScalar(input.rotation[2][i], s3, c3);
+
+        const glm::vec3 axes[3]{
+            { c1 * c3 + s1 * s2 * s3, c2 * s3, c1 * s2 * s3 - c3 * s1 },
+            { c3 * s1 * s2 - c1 * s3, c2 * c3, c1 * c3 * s2 + s1 * s3 },
+            { c2 * s1, -s2, c1 * c2 }
+        };
+
+        auto& model = *reinterpret_cast<glm::mat4*>(OutputAt(output.model, i, output.stride));
+        auto& normal = *reinterpret_cast<glm::mat4*>(OutputAt(output.normal, i, output.stride));
+        for (int column = 0; column < 3; column++) {
+            const float scale = input.scale[column][i];
+            model[column] = glm::vec4{ axes[column] * scale, 0.0f };
+            normal[column] = glm::vec4{ axes[column] / scale, 0.0f };
+        }
+        model[3] = glm::vec4{ input.translation[0][i], input.translation[1][i], input.translation[2][i], 1.0f };
+        normal[3] = glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f };
+    }
+}
+
+#if VKTEST_X86
+
+static inline void SinCosSse(__m128 x, __m128& sine, __m128& cosine) {
+    // cvtps rounds to nearest under the default MXCSR mode
+    const __m128i quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(s_TwoOverPi)));
+    const __m128 q = _mm_cvtepi32_ps(quadrant);
+
+    __m128 r = _mm_sub_ps(x, _mm_mul_ps(q, _mm_set1_ps(s_PiOver2A)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(s_PiOver2B)));
+    r = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(s_PiOver2C)));
+    const __m128 r2 = _mm_mul_ps(r, r);
+
+    __m128 s = _mm_add_ps(_mm_set1_ps(s_SinC2), _mm_mul_ps(r2, _mm_set1_ps(s_SinC3)));
+    s = _mm_add_ps(_mm_set1_ps(s_SinC1), _mm_mul_ps(r2, s));
+    s = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), s));
+
+    __m128 c = _mm_add_ps(_mm_set1_ps(s_CosC2), _mm_mul_ps(r2, _mm_set1_ps(s_CosC3)));
+    c = _mm_add_ps(_mm_set1_ps(s_CosC1), _mm_mul_ps(r2, c));
+    c = _mm_add_ps(
+        _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), r2)),
+        _mm_mul_ps(_mm_mul_ps(r2, r2), c));
+
+    // Odd quadrants swap sin and cos, quadrants 2 and 3 negate sin, 1 and 2 negate cos
+    const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+    const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+    const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+
+    sine = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s)), sinSign);
+    cosine = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c)), cosSign);
+}
+
+// Writes (a[l], b[l], c[l], d[l]) as column `column` of matrix l for the 4 lanes
+static inline void StoreColumnsSse(__m128 a, __m128 b, __m128 c, __m128 d, glm::mat4* base, size_t first, size_t stride, int column) {
+    _MM_TRANSPOSE4_PS(a, b, c, d);
+    _mm_storeu_ps(&(*reinterpret_cast<glm::mat4*>(OutputAt(base, first + 0, stride)))[column][0], a);
+    _mm_storeu_ps(&(*reinterpret_cast<glm::mat4*>(OutputAt(base, first + 1, stride)))[column][0], b);
+    _mm_storeu_ps(&(*reinterpret_cast<glm::mat4*>(OutputAt(base, first + 2, stride)))[column][0], c);
+    _mm_storeu_ps(&(*reinterpret_cast<glm::mat4*>(OutputAt(base, first + 3, stride)))[column][0], d);
+}
+
+void TransformKernel::ComputeSse(const Input& input, size_t count, const Output& output) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    const size_t wideCount = count & ~size_t(3);
+    for (size_t i = 0; i < wideCount; i += 4) {
+        __m128 s1, c1, s2, c2, s3, c3;
+        SinCosSse(_mm_loadu_ps(input.rotation[1] + i), s1, c1);
+        SinCosSse(_mm_loadu_ps(input.rotation[0] + i), s2, c2);
+        SinCosSse(_mm_loadu_ps(input.rotation[2] + i), s3, c3);
+
+        const __m128 s1s2 = _mm_mul_ps(s1, s2);
+        const __m128 c1s2 = _mm_mul_ps(c1, s2);
+        const __m128 axes[3][3]{
+            {
+                _mm_add_ps(_mm_mul_ps(c1, c3), _mm_mul_ps(s1s2, s3)),
+                _mm_mul_ps(c2, s3),
+                _mm_sub_ps(_mm_mul_ps(c1s2, s3), _mm_mul_ps(c3, s1))
+            },
+            {
+                _mm_sub_ps(_mm_mul_ps(s1s2, c3), _mm_mul_ps(c1, s3)),
+                _mm_mul_ps(c2, c3),
+                _mm_add_ps(_mm_mul_ps(c1s2, c3), _mm_mul_ps(s1, s3))
+            },
+            {
+                _mm_mul_ps(c2, s1),
+                _mm_xor_ps(s2, signMask),
+                _mm_mul_ps(c1, c2)
+            }
+        };
+
+        for (int column = 0; column < 3; column++) {
+            const __m128 scale = _mm_loadu_ps(input.scale[column] + i);
+            const __m128 invScale = _mm_div_ps(one, scale);
+            StoreColumnsSse(
+                _mm_mul_ps(axes[column][0], scale),
+                _mm_mul_ps(axes[column][1], scale),
+                _mm_mul_ps(axes[column][2], scale),
+                zero,
+                output.model, i, output.stride, column);
+            StoreColumnsSse(
+                _mm_mul_ps(axes[column][0], invScale),
+                _mm_mul_ps(axes[column][1], invScale),
+                _mm_mul_ps(axes[column][2], invScale),
+                zero,
+                output.normal, i, output.stride, column);
+        }
+
+        StoreColumnsSse(
+            _mm_loadu_ps(input.translation[0] + i),
+            _mm_loadu_ps(input.translation[1] + i),
+            _mm_loadu_ps(input.translation[2] + i),
+            one,
+            output.model, i, output.stride, 3);
+        StoreColumnsSse(zero, zero, zero, one, output.normal, i, output.stride, 3);
+    }
+
+    ComputeScalar(input, wideCount, count, output);
+}
+
+VKTEST_TARGET_AVX2
+static inline void SinCosAvx2(__m256 x, __m256& sine, __m256& cosine) {
+    const __m256i quadrant = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(s_TwoOverPi)));
+    const __m256 q = _mm256_cvtepi32_ps(quadrant);
+
+    __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(q, _mm256_set1_ps(s_PiOver2A)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(q, _mm256_set1_ps(s_PiOver2B)));
+    r = _mm256_sub_ps(r, _mm256_mul_ps(q, _mm256_set1_ps(s_PiOver2C)));
+    const __m256 r2 = _mm256_mul_ps(r, r);
+
+    __m256 s = _mm256_add_ps(_mm256_set1_ps(s_SinC2), _mm256_mul_ps(r2, _mm256_set1_ps(s_SinC3)));
+    s = _mm256_add_ps(_mm256_set1_ps(s_SinC1), _mm256_mul_ps(r2, s));
+    s = _mm256_add_ps(r, _mm256_mul_ps(_mm256_mul_ps(r, r2), s));
+
+    __m256 c = _mm256_add_ps(_mm256_set1_ps(s_CosC2), _mm256_mul_ps(r2, _mm256_set1_ps(s_CosC3)));
+    c = _mm256_add_ps(_mm256_set1_ps(s_CosC1), _mm256_mul_ps(r2, c));
+    c = _mm256_add_ps(
+        _mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(_mm256_set1_ps(0.5f), r2)),
+        _mm256_mul_ps(_mm256_mul_ps(r2, r2), c));
+
+    const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+    const __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(2)), 30));
+    const __m256 cosSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+
+    sine = _mm256_xor_ps(_mm256_blendv_ps(s, c, swap), sinSign);
+    cosine = _mm256_xor_ps(_mm256_blendv_ps(c, s, swap), cosSign);
+}
+
+// 4x4 transposes inside each 128 bit half, lanes 0-3 come out of the low halves and 4-7 of the high ones
+VKTEST_TARGET_AVX2
+static inline void StoreColumnsAvx2(__m256 a, __m256 b, __m256 c, __m256 d, glm::mat4* base, size_t first, size_t stride, int column) {
+    const __m256 t0 = _mm256_unpacklo_ps(a, b);
+    const __m256 t1 = _mm256_unpackhi_ps(a, b);
+    const __m256 t2 = _mm256_unpacklo_ps(c, d);
+    const __m256 t3 = _mm256_unpackhi_ps(c, d);
+
+    const __m256 rows[4]{
+        _mm256_shuffle_ps(t0, t2, 0x44),
+        _mm256_shuffle_ps(t0, t2, 0xEE),
+        _mm256_shuffle_ps(t1, t3, 0x44),
+        _mm256_shuffle_ps(t1, t3, 0xEE)
+    };
+
+    for (int lane = 0; lane < 4; lane++) {
+        _mm_storeu_ps(&(*reinterpret_cast<glm::mat4*>(OutputAt(base, first + lane, stride)))[column][0], _mm256_castps256_ps128(rows[lane]));
+        _mm_storeu_ps(&(*reinterpret_cast<glm::mat4*>(OutputAt(base, first + lane + 4, stride)))[column][0], _mm256_extractf128_ps(rows[lane], 1));
+    }
+}
+
+VKTEST_TARGET_AVX2
+void TransformKernel::ComputeAvx2(const Input& input, size_t count, const Output& output) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    const size_t wideCount = count & ~size_t(7);
+    for (size_t i = 0; i < wideCount; i += 8) {
+        __m256 s1, c1, s2, c2, s3, c3;
+        SinCosAvx2(_mm256_loadu_ps(input.rotation[1] + i), s1, c1);
+        SinCosAvx2(_mm256_loadu_ps(input.rotation[0] + i), s2, c2);
+        SinCosAvx2(_mm256_loadu_ps(input.rotation[2] + i), s3, c3);
+
+        const __m256 s1s2 = _mm256_mul_ps(s1, s2);
+        const __m256 c1s2 = _mm256_mul_ps(c1, s2);
+        const __m256 axes[3][3]{
+            {
+                _mm256_add_ps(_mm256_mul_ps(c1, c3), _mm256_mul_ps(s1s2, s3)),
+                _mm256_mul_ps(c2, s3),
+                _mm256_sub_ps(_mm256_mul_ps(c1s2, s3), _mm256_mul_ps(c3, s1))
+            },
+            {
+                _mm256_sub_ps(_mm256_mul_ps(s1s2, c3), _mm256_mul_ps(c1, s3)),
+                _mm256_mul_ps(c2, c3),
+                _mm256_add_ps(_mm256_mul_ps(c1s2, c3), _mm256_mul_ps(s1, s3))
+            },
+            {
+                _mm256_mul_ps(c2, s1),
+                _mm256_xor_ps(s2, signMask),
+                _mm256_mul_ps(c1, c2)
+            }
+        };
+
+        for (int column = 0; column < 3; column++) {
+            const __m256 scale = _mm256_loadu_ps(input.scale[column] + i);
+            const __m256 invScale = _mm256_div_ps(one, scale);
+            StoreColumnsAvx2(
+                _mm256_mul_ps(axes[column][0], scale),
+                _mm256_mul_ps(axes[column][1], scale),
+                _mm256_mul_ps(axes[column][2], scale),
+                zero,
+                output.model, i, output.stride, column);
+            StoreColumnsAvx2(
+                _mm256_mul_ps(axes[column][0], invScale),
+                _mm256_mul_ps(axes[column][1], invScale),
+                _mm256_mul_ps(axes[column][2], invScale),
+                zero,
+                output.normal, i, output.stride, column);
+        }
+
+        StoreColumnsAvx2(
+            _mm256_loadu_ps(input.translation[0] + i),
+            _mm256_loadu_ps(input.translation[1] + i),
+            _mm256_loadu_ps(input.translation[2] + i),
+            one,
+            output.model, i, output.stride, 3);
+        StoreColumnsAvx2(zero, zero, zero, one, output.normal, i, output.stride, 3);
+    }
+
+    ComputeScalar(input, wideCount, count, output);
+}
+
+#else
+
+void TransformKernel::ComputeSse(const Input& input, size_t count, const Output& output) {
+    ComputeScalar(input, 0, count, output);
+}
+
+void TransformKernel::ComputeAvx2(const Input& input, size_t count, const Output& output) {
+    ComputeScalar(input, 0, count, output);
+}
+
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <vector>
+
+// Builds model and normal matrices for many transforms at once. Same Euler convention as
+// TransformComponent::mat4() (Y, X, Z), but sin and cos come from one polynomial sincos per
+// angle that is shared by both matrices. 8 objects per step with AVX2, 4 with SSE, scalar
+// otherwise, picked at runtime.
+class TransformKernel {
+public:
+    // One stream per component, all count long
+    struct Input {
+        const float* translation[3];
+        const float* rotation[3];
+        const float* scale[3];
+    };
+
+    // Matrices are written at byte offsets i * stride, so they can go straight into
+    // interleaved GPU structs. The normal matrix is the 3x3 one widened like glm::mat4(mat3).
+    struct Output {
+        glm::mat4*  model;
+        glm::mat4*  normal;
+        size_t      stride = sizeof(glm::mat4);
+    };
+
+    // Collects transforms into the separate streams Compute() reads
+    struct Streams {
+        std::vector<float> translation[3];
+        std::vector<float> rotation[3];
+        std::vector<float> scale[3];
+
+        void Clear();
+        void Push(const glm::vec3& translationValue, const glm::vec3& rotationValue, const glm::vec3& scaleValue);
+        size_t Size() const { return translation[0].size(); }
+        Input GetInput() const;
+    };
+public:
+    static void Compute(const Input& input, size_t count, const Output& output);
+private:
+    static void ComputeScalar(const Input& input, size_t begin, size_t end, const Output& output);
+    static void ComputeSse(const Input& input, size_t count, const Output& output);
+    static void ComputeAvx2(const Input& input, size_t count, const Output& output);
+};
@@ -0,0 +1,200 @@
+#include "TransformSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+TransformSystem::TransformSystem(Scene& scene) : m_Scene{ scene } {
+}
+
+namespace {
+    // Upper bound on how much m stretches any direction. The largest singular value is the
+    // square root of the largest eigenvalue of M^T M, which no row sum of |M^T M| falls below.
+    // Unlike the longest column this holds under shear, and it is exact for rotation and scale.
+    float MaxScale(const glm::mat4& m) {
+        const glm::mat3 linear{ m };
+        const glm::mat3 gram = glm::transpose(linear) * linear;
+        float maxRowSum = 0.0f;
+        for (int row = 0; row < 3; row++) {
+            maxRowSum = std::max(maxRowSum, std::abs(gram[0][row]) + std::abs(gram[1][row]) + std::abs(gram[2][row]));
+        }
+        return std::sqrt(maxRowSum);
+    }
+}
+
+void TransformSystem::Attach(Entity entity, const TransformComponent& transform) {
+    // Already attached, keep its place in the hierarchy
+    if (m_Scene.Has<HierarchyComponent>(entity)) {
+        Edit(entity) = transform;
+        return;
+    }
+
+    m_Scene.Add<TransformComponent>(entity, transform);
+    m_Scene.Add<HierarchyComponent>(entity);
+    m_Scene.Add<WorldTransformComponent>(entity);
+    m_Dirty.push_back(entity);
+}
+
+void TransformSystem::Destroy(Entity entity) {
+    if (!m_Scene.IsAlive(entity)) {
+        return;
+    }
+
+    auto* hierarchy = m_Scene.TryGet<HierarchyComponent>(entity);
+    if (!hierarchy) {
+        m_Scene.Destroy(entity);
+        return;
+    }
+
+    Unlink(entity, *hierarchy);
+
+    m_Stack.clear();
+    m_Stack.push_back(entity);
+    while (!m_Stack.empty()) {
+        const Entity current = m_Stack.back();
+        m_Stack.pop_back();
+
+        for (Entity child = m_Scene.Get<HierarchyComponent>(current).firstChild; child.IsValid();) {
+            m_Stack.push_back(child);
+            child = m_Scene.Get<HierarchyComponent>(child).nextSibling;
+        }
+        m_Scene.Destroy(current);
+    }
+}
+
+void TransformSystem::SetParent(Entity child, Entity parent) {
+    for (Entity ancestor = parent; ancestor.IsValid(); ancestor = m_Scene.Get<HierarchyComponent>(ancestor).parent) {
+        if (ancestor == child) {
+            throw std::runtime_error("cannot parent an entity to itself or its descendant!");
+        }
+    }
+
+    auto& hierarchy = m_Scene.Get<HierarchyComponent>(child);
+    Unlink(child, hierarchy);
+
+    if (parent.IsValid()) {
+        auto& parentHierarchy = m_Scene.Get<HierarchyComponent>(parent);
+        hierarchy.parent = parent;
+        hierarchy.nextSibling = parentHierarchy.firstChild;
+        if (parentHierarchy.firstChild.IsValid()) {
+            m_Scene.Get<HierarchyComponent>(parentHierarchy.firstChild).prevSibling = child;
+        }
+        parentHierarchy.firstChild = child;
+    }
+
+    UpdateDepths(child);
+    MarkDirty(child);
+}
+
+void TransformSystem::MarkDirty(Entity entity) {
+    auto& cache = m_Scene.Get<WorldTransformComponent>(entity);
+    if (!cache.dirty) {
+        cache.dirty = true;
+        m_Dirty.push_back(entity);
+    }
+}
+
+void TransformSystem::Update() {
+    m_LastUpdateCount = 0;
+
+    // Entities destroyed since they were marked are dropped here
+    m_Dirty.erase(
+        std::remove_if(m_Dirty.begin(), m_Dirty.end(), [this](Entity entity) {
+            return !m_Scene.IsAlive(entity) || !m_Scene.Has<WorldTransformComponent>(entity);
+        }),
+        m_Dirty.end());
+    if (m_Dirty.empty()) {
+        return;
+    }
+
+    m_LocalStreams.Clear();
+    for (Entity entity : m_Dirty) {
+        const auto& transform = m_Scene.Get<TransformComponent>(entity);
+        m_LocalStreams.Push(transform.translation, transform.rotation, transform.scale);
+    }
+
+    const size_t count = m_Dirty.size();
+    m_LocalMatrices.resize(count);
+    m_LocalNormals.resize(count);
+    TransformKernel::Compute(m_LocalStreams.GetInput(), count, { m_LocalMatrices.data(), m_LocalNormals.data() });
+
+    for (size_t i = 0; i < count; i++) {
+        auto& cache = m_Scene.Get<WorldTransformComponent>(m_Dirty[i]);
+        cache.local = m_LocalMatrices[i];
+        cache.localNormal = m_LocalNormals[i];
+    }
+
+    // Shallowest first, so a dirty descendant is already covered by its ancestor's pass
+    std::sort(m_Dirty.begin(), m_Dirty.end(), [this](Entity a, Entity b) {
+        return m_Scene.Get<HierarchyComponent>(a).depth < m_Scene.Get<HierarchyComponent>(b).depth;
+    });
+
+    for (Entity entity : m_Dirty) {
+        if (m_Scene.Get<WorldTransformComponent>(entity).dirty) {
+            PropagateSubtree(entity);
+        }
+    }
+    m_Dirty.clear();
+}
+
+void TransformSystem::Unlink(Entity entity, HierarchyComponent& hierarchy) {
+    if (hierarchy.prevSibling.IsValid()) {
+        m_Scene.Get<HierarchyComponent>(hierarchy.prevSibling).nextSibling = hierarchy.nextSibling;
+    }
+    else if (hierarchy.parent.IsValid()) {
+        m_Scene.Get<HierarchyComponent>(hierarchy.parent).firstChild = hierarchy.nextSibling;
+    }
+
+    if (hierarchy.nextSibling.IsValid()) {
+        m_Scene.Get<HierarchyComponent>(hierarchy.nextSibling).prevSibling = hierarchy.prevSibling;
+    }
+
+    hierarchy.parent = {};
+    hierarchy.prevSibling = {};
+    hierarchy.nextSibling = {};
+}
+
+void TransformSystem::UpdateDepths(Entity root) {
+    m_Stack.clear();
+    m_Stack.push_back(root);
+    while (!m_Stack.empty()) {
+        const Entity current = m_Stack.back();
+        m_Stack.pop_back();
+
+        auto& hierarchy = m_Scene.Get<HierarchyComponent>(current);
+        hierarchy.depth = hierarchy.parent.IsValid() ? m_Scene.Get<HierarchyComponent>(hierarchy.parent).depth + 1 : 0;
+
+        for (Entity child = hierarchy.firstChild; child.IsValid(); child = m_Scene.Get<HierarchyComponent>(child).nextSibling) {
+            m_Stack.push_back(child);
+        }
+    }
+}
+
+void TransformSystem::PropagateSubtree(Entity root) {
+    m_Stack.clear();
+    m_Stack.push_back(root);
+    while (!m_Stack.empty()) {
+        const Entity current = m_Stack.back();
+        m_Stack.pop_back();
+
+        const auto& hierarchy = m_Scene.Get<HierarchyComponent>(current);
+        auto& cache = m_Scene.Get<WorldTransformComponent>(current);
+        if (hierarchy.parent.IsValid()) {
+            // (P * L)^-T = P^-T * L^-T, so normal matrices chain like the transforms
+            const auto& parentCache = m_Scene.Get<WorldTransformComponent>(hierarchy.parent);
+            cache.world = parentCache.world * cache.local;
+            cache.normal = parentCache.normal * cache.localNormal;
+        }
+        else {
+            cache.world = cache.local;
+            cache.normal = cache.localNormal;
+        }
+        cache.maxScale = MaxScale(cache.world);
+        cache.dirty = false;
+        m_LastUpdateCount++;
+
+        for (Entity child = hierarchy.firstChild; child.IsValid(); child = m_Scene.Get<HierarchyComponent>(child).nextSibling) {
+            m_Stack.push_back(child);
+        }
+    }
+}
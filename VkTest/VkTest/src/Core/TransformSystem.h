@@ -0,0 +1,59 @@
+#pragma once
+
+#include <Core/Components.h>
+#include <Core/Scene.h>
+#include <Core/TransformKernel.h>
+
+#include <vector>
+
+// Parent/child relationships and cached matrices for the entities of a scene. After a
+// TransformComponent changes, call MarkDirty() (or change it through Edit()). Update()
+// then rebuilds only the dirty locals and the world matrices of the subtrees below them,
+// parents before children. Entities that never change cost nothing per frame.
+class TransformSystem {
+public:
+    explicit TransformSystem(Scene& scene);
+    ~TransformSystem() = default;
+
+    TransformSystem(const TransformSystem&) = delete;
+    TransformSystem& operator=(const TransformSystem&) = delete;
+
+    TransformSystem(TransformSystem&&) = delete;
+    TransformSystem& operator=(TransformSystem&&) = delete;
+public:
+    // Gives the entity a transform and makes it a root of the hierarchy. On an entity that
+    // already has one, only replaces the local transform.
+    void Attach(Entity entity, const TransformComponent& transform = {});
+    // Destroys the entity and all of its descendants
+    void Destroy(Entity entity);
+
+    // The local transform is kept, so the child moves along with its new parent.
+    // An invalid parent makes the entity a root.
+    void SetParent(Entity child, Entity parent);
+    Entity GetParent(Entity entity) { return m_Scene.Get<HierarchyComponent>(entity).parent; }
+
+    void MarkDirty(Entity entity);
+    TransformComponent& Edit(Entity entity) {
+        MarkDirty(entity);
+        return m_Scene.Get<TransformComponent>(entity);
+    }
+
+    void Update();
+
+    const glm::mat4& GetWorldMatrix(Entity entity) { return m_Scene.Get<WorldTransformComponent>(entity).world; }
+    size_t GetLastUpdateCount() const { return m_LastUpdateCount; }
+private:
+    void Unlink(Entity entity, HierarchyComponent& hierarchy);
+    void UpdateDepths(Entity root);
+    void PropagateSubtree(Entity root);
+private:
+    Scene&						m_Scene;
+    std::vector<Entity>			m_Dirty;
+    std::vector<Entity>			m_Stack;
+    size_t						m_LastUpdateCount = 0;  // world matrices rebuilt by the last Update()
+
+    // Dirty locals are rebuilt in one batch
+    TransformKernel::Streams	m_LocalStreams;
+    std::vector<glm::mat4>		m_LocalMatrices;
+    std::vector<glm::mat4>		m_LocalNormals;
+};
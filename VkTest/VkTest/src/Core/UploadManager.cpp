@@ -0,0 +1,423 @@
+#include "UploadManager.h"
+
+#include <Core/Device.h>
+#include <Core/Trace.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+UploadManager::UploadManager(Device& device)
+    : m_Device{ device } {
+    m_Queue = m_Device.TransferQueue();
+    m_TransfersOwnership = m_Device.HasDedicatedTransferQueue();
+    m_SrcFamily = m_Device.TransferFamily();
+    m_DstFamily = m_Device.FindPhysicalQueueFamilies().m_GraphicsFamily;
+
+    VkCommandPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    poolInfo.queueFamilyIndex = m_SrcFamily;
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT | VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+
+    if (vkCreateCommandPool(m_Device.GetDevice(), &poolInfo, nullptr, &m_CommandPool) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create upload command pool!");
+    }
+
+    m_Batches.resize(s_MaxBatchesInFlight);
+    for (auto& batch : m_Batches) {
+        VkCommandBufferAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        allocInfo.commandPool = m_CommandPool;
+        allocInfo.commandBufferCount = 1;
+
+        if (vkAllocateCommandBuffers(m_Device.GetDevice(), &allocInfo, &batch.commandBuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to allocate upload command buffer!");
+        }
+
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+        if (vkCreateFence(m_Device.GetDevice(), &fenceInfo, nullptr, &batch.fence) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create upload fence!");
+        }
+
+        m_FreeBatches.push_back(&batch);
+    }
+
+    m_Device.CreateBuffer(
+        s_StagingSize,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+        m_StagingBuffer,
+        m_StagingMemory);
+}
+
+UploadManager::~UploadManager() {
+    WaitIdle();
+
+    for (auto& batch : m_Batches) {
+        vkDestroyFence(m_Device.GetDevice(), batch.fence, nullptr);
+    }
+    vkDestroyCommandPool(m_Device.GetDevice(), m_CommandPool, nullptr);
+    m_Device.DestroyBuffer(m_StagingBuffer, m_StagingMemory);
+}
+
+UploadManager::Ticket UploadManager::UploadBuffer(
+        VkBuffer dstBuffer,
+        VkDeviceSize dstOffset,
+        const void* data,
+        VkDeviceSize size) {
+    TRACE_ZONE("UploadManager::UploadBuffer");
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    const char* src = static_cast<const char*>(data);
+    Ticket ticket = m_CompletedTicket;
+
+    while (size > 0) {
+        const VkDeviceSize chunkSize = std::min(size, s_StagingSize);
+        const uint64_t stagingOffset = ReserveStaging(chunkSize);
+        memcpy(static_cast<char*>(m_StagingMemory.mappedData) + stagingOffset, src, static_cast<size_t>(chunkSize));
+
+        Batch& batch = GetOpenBatch();
+
+        VkBufferCopy copyRegion{};
+        copyRegion.srcOffset = stagingOffset;
+        copyRegion.dstOffset = dstOffset;
+        copyRegion.size = chunkSize;
+        vkCmdCopyBuffer(batch.commandBuffer, m_StagingBuffer, dstBuffer, 1, &copyRegion);
+        batch.copyCount++;
+
+        if (m_TransfersOwnership) {
+            VkBufferMemoryBarrier release{};
+            release.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+            release.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            release.dstAccessMask = 0;
+            release.srcQueueFamilyIndex = m_SrcFamily;
+            release.dstQueueFamilyIndex = m_DstFamily;
+            release.buffer = dstBuffer;
+            release.offset = dstOffset;
+            release.size = chunkSize;
+            batch.bufferReleases.push_back(release);
+        }
+
+        ticket = batch.ticket;
+        src += chunkSize;
+        dstOffset += chunkSize;
+        size -= chunkSize;
+    }
+
+    return ticket;
+}
+
+UploadManager::Ticket UploadManager::UploadImage(
+        VkImage dstImage,
+        uint32_t width,
+        uint32_t height,
+        uint32_t layerCount,
+        const void* data,
+        VkDeviceSize size,
+        VkImageLayout finalLayout) {
+    TRACE_ZONE("UploadManager::UploadImage");
+    if (size > s_StagingSize) {
+        throw std::runtime_error("image upload does not fit into the staging ring!");
+    }
+
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    const uint64_t stagingOffset = ReserveStaging(size);
+    memcpy(static_cast<char*>(m_StagingMemory.mappedData) + stagingOffset, data, static_cast<size_t>(size));
+
+    Batch& batch = GetOpenBatch();
+
+    VkImageMemoryBarrier toTransfer{};
+    toTransfer.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    toTransfer.srcAccessMask = 0;
+    toTransfer.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    toTransfer.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    toTransfer.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    toTransfer.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    toTransfer.image = dstImage;
+    toTransfer.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    toTransfer.subresourceRange.baseMipLevel = 0;
+    toTransfer.subresourceRange.levelCount = 1;
+    toTransfer.subresourceRange.baseArrayLayer = 0;
+    toTransfer.subresourceRange.layerCount = layerCount;
+
+    vkCmdPipelineBarrier(
+        batch.commandBuffer,
+        VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        0,
+        0, nullptr,
+        0, nullptr,
+        1, &toTransfer);
+
+    VkBufferImageCopy region{};
+    region.bufferOffset = stagingOffset;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = layerCount;
+
+    region.imageOffset = { 0, 0, 0 };
+    region.imageExtent = { width, height, 1 };
+
+    vkCmdCopyBufferToImage(
+        batch.commandBuffer,
+        m_StagingBuffer,
+        dstImage,
+        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        1,
+        &region);
+    batch.copyCount++;
+
+    // Doubles as the layout transition; on a shared queue it is recorded without an ownership change
+    VkImageMemoryBarrier release = toTransfer;
+    release.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    release.dstAccessMask = m_TransfersOwnership ? 0 : VK_ACCESS_SHADER_READ_BIT;
+    release.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    release.newLayout = finalLayout;
+    if (m_TransfersOwnership) {
+        release.srcQueueFamilyIndex = m_SrcFamily;
+        release.dstQueueFamilyIndex = m_DstFamily;
+    }
+    batch.imageReleases.push_back(release);
+
+    return batch.ticket;
+}
+
+UploadManager::Ticket UploadManager::Flush() {
+    TRACE_ZONE("UploadManager::Flush");
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    RetireCompleted();
+    if (m_pOpenBatch) {
+        SubmitOpenBatch();
+    }
+
+    return m_NextTicket - 1;
+}
+
+void UploadManager::AcquireUploads(VkCommandBuffer commandBuffer) {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    RetireCompleted();
+    if (!m_TransfersOwnership) {
+        return;
+    }
+
+    if (!m_PendingBufferAcquires.empty() || !m_PendingImageAcquires.empty()) {
+        vkCmdPipelineBarrier(
+            commandBuffer,
+            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            0,
+            0, nullptr,
+            static_cast<uint32_t>(m_PendingBufferAcquires.size()), m_PendingBufferAcquires.data(),
+            static_cast<uint32_t>(m_PendingImageAcquires.size()), m_PendingImageAcquires.data());
+
+        m_PendingBufferAcquires.clear();
+        m_PendingImageAcquires.clear();
+    }
+
+    m_AcquiredTicket = m_CompletedTicket;
+}
+
+void UploadManager::DiscardAcquires(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size) {
+    if (!m_TransfersOwnership || size == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    // A release that is never acquired is fine, the range's old contents are not needed
+    auto discard = [&](std::vector<VkBufferMemoryBarrier>& barriers) {
+        barriers.erase(
+            std::remove_if(barriers.begin(), barriers.end(), [&](const VkBufferMemoryBarrier& barrier) {
+                return barrier.buffer == buffer && barrier.offset < offset + size && offset < barrier.offset + barrier.size;
+            }),
+            barriers.end());
+    };
+
+    discard(m_PendingBufferAcquires);
+    for (Batch* batch : m_InFlight) {
+        discard(batch->bufferReleases);
+    }
+    if (m_pOpenBatch) {
+        discard(m_pOpenBatch->bufferReleases);
+    }
+}
+
+bool UploadManager::IsComplete(Ticket ticket) {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    RetireCompleted();
+    return ticket <= m_CompletedTicket;
+}
+
+bool UploadManager::IsReady(Ticket ticket) {
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    RetireCompleted();
+    return ticket <= (m_TransfersOwnership ? m_AcquiredTicket : m_SubmittedTicket);
+}
+
+void UploadManager::Wait(Ticket ticket) {
+    TRACE_ZONE("UploadManager::Wait");
+    std::lock_guard<std::mutex> lock{ m_Mutex };
+
+    if (m_pOpenBatch && m_pOpenBatch->ticket <= ticket) {
+        SubmitOpenBatch();
+    }
+
+    while (ticket > m_CompletedTicket && !m_InFlight.empty()) {
+        RetireOldest();
+    }
+}
+
+void UploadManager::WaitIdle() {
+    Wait(m_NextTicket - 1);
+}
+
+uint64_t UploadManager::ReserveStaging(VkDeviceSize size) {
+    size = (size + s_StagingAlignment - 1) & ~(s_StagingAlignment - 1);
+
+    // A range never straddles the end of the ring, skip the tail instead
+    const uint64_t position = m_RingHead % s_StagingSize;
+    const uint64_t padding = position + size > s_StagingSize ? s_StagingSize - position : 0;
+
+    while (m_RingHead + padding + size - m_RingTail > s_StagingSize) {
+        if (m_InFlight.empty()) {
+            if (!m_pOpenBatch) {
+                m_RingTail = m_RingHead + padding;
+                break;
+            }
+            SubmitOpenBatch();
+        }
+        RetireOldest();
+    }
+
+    m_RingHead += padding;
+    const uint64_t offset = m_RingHead % s_StagingSize;
+    m_RingHead += size;
+
+    return offset;
+}
+
+UploadManager::Batch& UploadManager::GetOpenBatch() {
+    if (m_pOpenBatch) {
+        return *m_pOpenBatch;
+    }
+
+    if (m_FreeBatches.empty()) {
+        RetireOldest();
+    }
+
+    m_pOpenBatch = m_FreeBatches.back();
+    m_FreeBatches.pop_back();
+
+    m_pOpenBatch->ticket = m_NextTicket++;
+    m_pOpenBatch->copyCount = 0;
+    m_pOpenBatch->bufferReleases.clear();
+    m_pOpenBatch->imageReleases.clear();
+
+    vkResetFences(m_Device.GetDevice(), 1, &m_pOpenBatch->fence);
+    vkResetCommandBuffer(m_pOpenBatch->commandBuffer, 0);
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    if (vkBeginCommandBuffer(m_pOpenBatch->commandBuffer, &beginInfo) != VK_SUCCESS) {
+        throw std::runtime_error("failed to begin upload command buffer!");
+    }
+
+    return *m_pOpenBatch;
+}
+
+void UploadManager::SubmitOpenBatch() {
+    Batch& batch = *m_pOpenBatch;
+
+    if (m_TransfersOwnership) {
+        vkCmdPipelineBarrier(
+            batch.commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            0,
+            0, nullptr,
+            static_cast<uint32_t>(batch.bufferReleases.size()), batch.bufferReleases.data(),
+            static_cast<uint32_t>(batch.imageReleases.size()), batch.imageReleases.data());
+    }
+    else {
+        // Later submissions on this queue see the copies once they reach vertex input
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask =
+            VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+
+        vkCmdPipelineBarrier(
+            batch.commandBuffer,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+            0,
+            1, &barrier,
+            0, nullptr,
+            static_cast<uint32_t>(batch.imageReleases.size()), batch.imageReleases.data());
+    }
+
+    if (vkEndCommandBuffer(batch.commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("failed to record upload command buffer!");
+    }
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &batch.commandBuffer;
+
+    if (vkQueueSubmit(m_Queue, 1, &submitInfo, batch.fence) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit upload batch!");
+    }
+    m_SubmittedTicket = batch.ticket;
+
+    batch.ringEnd = m_RingHead;
+    m_InFlight.push_back(&batch);
+    m_pOpenBatch = nullptr;
+}
+
+void UploadManager::RetireCompleted() {
+    while (!m_InFlight.empty() && vkGetFenceStatus(m_Device.GetDevice(), m_InFlight.front()->fence) == VK_SUCCESS) {
+        RetireOldest();
+    }
+}
+
+void UploadManager::RetireOldest() {
+    Batch* batch = m_InFlight.front();
+    vkWaitForFences(m_Device.GetDevice(), 1, &batch->fence, VK_TRUE, UINT64_MAX);
+
+    m_RingTail = batch->ringEnd;
+    m_CompletedTicket = batch->ticket;
+
+    // The matching acquire has to repeat the release exactly, only the access masks move
+    for (auto barrier : batch->bufferReleases) {
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask =
+            VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_UNIFORM_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+        m_PendingBufferAcquires.push_back(barrier);
+    }
+    for (auto barrier : batch->imageReleases) {
+        if (m_TransfersOwnership) {
+            barrier.srcAccessMask = 0;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            m_PendingImageAcquires.push_back(barrier);
+        }
+    }
+
+    m_InFlight.pop_front();
+    m_FreeBatches.push_back(batch);
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <Core/MemoryAllocator.h>
+
+#include <vulkan/vulkan.h>
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+class Device;
+
+// Batches staging copies into one command buffer per submit. Staging data lives in a
+// persistently mapped ring, batches complete on a fence and the ring space behind them
+// is reclaimed once it signals, so nothing ever waits for the whole queue to go idle.
+// Batches go to the device's transfer queue. When that is a dedicated family, every
+// destination is released at the end of its batch and acquired by the graphics queue in
+// AcquireUploads() once the fence has signalled.
+class UploadManager {
+public:
+    using Ticket = uint64_t;
+
+    static constexpr VkDeviceSize s_StagingSize = 16ull * 1024 * 1024;
+    static constexpr VkDeviceSize s_StagingAlignment = 16;
+    static constexpr uint32_t s_MaxBatchesInFlight = 4;
+public:
+    UploadManager(Device& device);
+    ~UploadManager();
+
+    UploadManager(const UploadManager&) = delete;
+    UploadManager& operator=(const UploadManager&) = delete;
+
+    UploadManager(UploadManager&&) = delete;
+    UploadManager& operator=(UploadManager&&) = delete;
+public:
+    // Copies data into the ring and records a copy to dstBuffer. The copy is submitted by
+    // the next Flush(); the returned ticket completes when the data has landed.
+    Ticket UploadBuffer(VkBuffer dstBuffer, VkDeviceSize dstOffset, const void* data, VkDeviceSize size);
+    // Fills mip 0 of a color image, leaving it in finalLayout.
+    Ticket UploadImage(
+        VkImage dstImage,
+        uint32_t width,
+        uint32_t height,
+        uint32_t layerCount,
+        const void* data,
+        VkDeviceSize size,
+        VkImageLayout finalLayout);
+
+    Ticket Flush();
+    // Records queue family acquire barriers for finished batches into a graphics command buffer.
+    void AcquireUploads(VkCommandBuffer commandBuffer);
+    // Drops the acquires still owed for a buffer range that is about to be handed out again,
+    // so they cannot land on a later upload into the same range while it is being copied.
+    void DiscardAcquires(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size);
+
+    // Copy has finished on the GPU
+    bool IsComplete(Ticket ticket);
+    // Destination may be used by graphics commands recorded from now on
+    bool IsReady(Ticket ticket);
+    void Wait(Ticket ticket);
+    void WaitIdle();
+private:
+    struct Batch {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkFence         fence = VK_NULL_HANDLE;
+        Ticket          ticket = 0;
+        uint64_t        ringEnd = 0;
+        uint32_t        copyCount = 0;
+
+        std::vector<VkBufferMemoryBarrier>  bufferReleases;
+        std::vector<VkImageMemoryBarrier>   imageReleases;
+    };
+private:
+    uint64_t ReserveStaging(VkDeviceSize size);
+    Batch& GetOpenBatch();
+    void SubmitOpenBatch();
+    void RetireCompleted();
+    void RetireOldest();
+private:
+    Device&             m_Device;
+    VkCommandPool       m_CommandPool;
+    VkQueue             m_Queue;
+    bool                m_TransfersOwnership;
+    uint32_t            m_SrcFamily;
+    uint32_t            m_DstFamily;
+
+    VkBuffer            m_StagingBuffer;
+    MemoryAllocation    m_StagingMemory;
+    uint64_t            m_RingHead = 0;     // monotonic, wraps modulo s_StagingSize
+    uint64_t            m_RingTail = 0;
+
+    std::vector<Batch>  m_Batches;
+    std::vector<Batch*> m_FreeBatches;
+    std::deque<Batch*>  m_InFlight;
+    Batch*              m_pOpenBatch = nullptr;
+
+    std::vector<VkBufferMemoryBarrier>  m_PendingBufferAcquires;
+    std::vector<VkImageMemoryBarrier>   m_PendingImageAcquires;
+
+    Ticket              m_NextTicket = 1;
+    Ticket              m_SubmittedTicket = 0;
+    Ticket              m_CompletedTicket = 0;
+    Ticket              m_AcquiredTicket = 0;
+    std::mutex          m_Mutex;
+};
@@ -0,0 +1,41 @@
+#include "Utils.h"
+
+#include <filesystem>
+#include <fstream>
+
+uint64_t hashBytes(const void* data, std::size_t size) {
+	uint64_t hash = 0xcbf29ce484222325ull;
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (std::size_t i = 0; i < size; i++) {
+		hash ^= bytes[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+bool writeFileAtomic(const std::string& filepath, std::initializer_list<std::pair<const void*, std::size_t>> chunks) {
+	const std::string tmpPath = filepath + ".tmp";
+	{
+		std::ofstream file{ tmpPath, std::ios_base::binary | std::ios_base::trunc };
+		if (!file.is_open()) {
+			return false;
+		}
+
+		for (const auto& [data, size] : chunks) {
+			file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+		}
+
+		if (!file.good()) {
+			return false;
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(tmpPath, filepath, ec);
+	if (ec) {
+		std::filesystem::remove(tmpPath, ec);
+		return false;
+	}
+
+	return true;
+}
@@ -1,7 +1,21 @@
-#pragma once
-
-template <typename T, typename... Rest>
-void hashCombine(std::size_t& seed, const T& v, const Rest&... rest) {
-	seed ^= std::hash<T>{}(v)+0x9e3779b9 + (seed << 6) + (seed >> 2);
-	(hashCombine(seed, rest), ...);
-}
\ No newline at end of file
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <utility>
+
+template <typename T, typename... Rest>
+void hashCombine(std::size_t& seed, const T& v, const Rest&... rest) {
+	seed ^= std::hash<T>{}(v)+0x9e3779b9 + (seed << 6) + (seed >> 2);
+	(hashCombine(seed, rest), ...);
+}
+
+// FNV-1a, 64 bit. Stable across runs and platforms, unlike std::hash, so it can go into files.
+uint64_t hashBytes(const void* data, std::size_t size);
+
+// Writes the chunks in order to a temporary file and renames it over filepath, so a crash
+// never leaves a truncated file behind. False if anything failed, filepath is untouched then.
+bool writeFileAtomic(const std::string& filepath, std::initializer_list<std::pair<const void*, std::size_t>> chunks);
@@ -0,0 +1,39 @@
+#version 450
+
+#extension GL_GOOGLE_include_directive : require
+#include "vertex_input.glsl"
+
+layout (location=0) out vec3 fragColor;
+
+struct ObjectData {
+	mat4 transform;
+	mat4 normalMatrix;
+	uint meshIndex;
+	uint drawBase;
+	uint batch;
+};
+
+layout (std430, set=0, binding=0) readonly buffer Objects {
+	ObjectData objects[];
+};
+
+layout (push_constant) uniform Push{
+	mat4 transform;
+	mat4 normalMatrix;
+} push;
+
+const vec3 DIRECTION_TO_LIGHT = normalize(vec3(1.0f, -3.0f, 1.0f));
+const float AMBIENT = 0.02f;
+
+void main(){
+	// firstInstance of each indirect draw is the object index
+	ObjectData object = objects[gl_InstanceIndex];
+
+	gl_Position = push.transform * object.transform * vec4(VertexPosition(), 1.0f);
+
+	vec3 normalWorldSpace = normalize(mat3(object.normalMatrix) * VertexNormal());
+
+	float lightIntensity = AMBIENT + max(dot(normalWorldSpace, DIRECTION_TO_LIGHT), 0);
+
+	fragColor = lightIntensity * VertexColor();
+}
\ No newline at end of file
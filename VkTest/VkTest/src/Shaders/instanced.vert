@@ -0,0 +1,27 @@
+#version 450
+
+#extension GL_GOOGLE_include_directive : require
+#include "vertex_input.glsl"
+
+layout (location=4) in mat4 instanceTransform;
+layout (location=8) in mat4 instanceNormalMatrix;
+
+layout (location=0) out vec3 fragColor;
+
+layout (push_constant) uniform Push{
+	mat4 transform;
+	mat4 normalMatrix;
+} push;
+
+const vec3 DIRECTION_TO_LIGHT = normalize(vec3(1.0f, -3.0f, 1.0f));
+const float AMBIENT = 0.02f;
+
+void main(){
+	gl_Position = push.transform * instanceTransform * vec4(VertexPosition(), 1.0f);
+
+	vec3 normalWorldSpace = normalize(mat3(instanceNormalMatrix) * VertexNormal());
+
+	float lightIntensity = AMBIENT + max(dot(normalWorldSpace, DIRECTION_TO_LIGHT), 0);
+
+	fragColor = lightIntensity * VertexColor();
+}
\ No newline at end of file
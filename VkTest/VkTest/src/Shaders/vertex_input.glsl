@@ -0,0 +1,48 @@
+// Vertex attributes 0-3 for both Model vertex formats. Compiled with -DPACKED_VERTEX the
+// shader reads Model::PackedVertex, whose positions stay in [-1, 1] across the mesh AABB
+// because the dequantization is already part of the model matrix.
+
+#ifdef PACKED_VERTEX
+
+layout (location=0) in vec4 inPosition;
+layout (location=1) in vec4 inColor;
+layout (location=2) in vec2 inNormal;
+layout (location=3) in vec2 inUv;
+
+vec3 VertexPosition() {
+	return inPosition.xyz;
+}
+
+vec3 VertexColor() {
+	return inColor.rgb;
+}
+
+// Unfolds the octahedral encoding written by Model::PackedVertex::Pack
+vec3 VertexNormal() {
+	vec3 n = vec3(inNormal, 1.0f - abs(inNormal.x) - abs(inNormal.y));
+	float t = max(-n.z, 0.0f);
+	n.x += n.x >= 0.0f ? -t : t;
+	n.y += n.y >= 0.0f ? -t : t;
+	return normalize(n);
+}
+
+#else
+
+layout (location=0) in vec3 inPosition;
+layout (location=1) in vec3 inColor;
+layout (location=2) in vec3 inNormal;
+layout (location=3) in vec2 inUv;
+
+vec3 VertexPosition() {
+	return inPosition;
+}
+
+vec3 VertexColor() {
+	return inColor;
+}
+
+vec3 VertexNormal() {
+	return inNormal;
+}
+
+#endif